@@ -14,10 +14,83 @@
 #include <iostream>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <exception>
+#include <stdexcept>
+#include <chrono>
 #include "Util.h"
 #include "Table.h"
+#include "Simulation.h"
+#include "Snapshot.h"
+#include "MappedFile.h"
+#include "Shutdown.h"
 #include "StrategyLookup.h"
 
+// usage: display the command line options
+static void usage(FILE *fptr)
+{
+	fprintf(fptr, "usage: blackjack [options] [strategy]\n");
+	fprintf(fptr, "       blackjack [-o <file>] -r <file> <snapshot>...\n\n");
+	fprintf(fptr, "options:\n");
+	fprintf(fptr, "  -n <hands>    play <hands> hands, then write a final report\n");
+	fprintf(fptr, "  -t <seconds>  play for <seconds>, then write a final report\n");
+	fprintf(fptr, "  -o <file>     write the final report to <file>\n");
+	fprintf(fptr, "  -j <threads>  run on <threads> threads in batch mode (default:\n");
+	fprintf(fptr, "                one per hardware thread)\n");
+	fprintf(fptr, "  -s <seed>     seed the random number generator (a run is\n");
+	fprintf(fptr, "                reproducible given its seed and thread count)\n");
+	fprintf(fptr, "  -l            lazy shuffle: shuffle each card as it is dealt\n");
+	fprintf(fptr, "  -w <file>     write a snapshot of the results to <file>\n");
+	fprintf(fptr, "  -c <file>     checkpoint each thread to <file>.<thread> every\n");
+	fprintf(fptr, "                minute (see -i) and at the end of the run\n");
+	fprintf(fptr, "  -i <seconds>  checkpoint every <seconds> instead\n");
+	fprintf(fptr, "  --resume      carry on from the checkpoints given by -c\n");
+	fprintf(fptr, "  -H <file>     log every round to <file>.<thread> (a binary\n");
+	fprintf(fptr, "                hand history, see HandHistory.h)\n");
+	fprintf(fptr, "  -r <file>     reduce: merge the given snapshots into <file>\n");
+	fprintf(fptr, "                and write their combined report\n");
+	fprintf(fptr, "\nstrategies:\n");
+
+	StrategyList(fptr);
+
+	fprintf(fptr, "\nor the path to a strategy chart file (see the README.)\n\n");
+}
+
+// reduce: merge the snapshot files into one, write it to path and
+//         report on it
+static int reduce(const char *path, const char **inputs, int count,
+ FILE *fptr)
+{
+	Snapshot snapshot;
+
+	for(int i = 0; i < count; i++)
+	{
+		try {
+			MappedFile file(inputs[i]);
+
+			snapshot.merge(Snapshot::validate(file.getData(),
+			 file.getSize()));
+		}
+		catch(std::exception &e) {
+			fprintf(stderr, "%s: %s\n", inputs[i], e.what());
+			return 1;
+		}
+	}
+
+	try {
+		snapshot.write(path);
+	}
+	catch(std::exception &e) {
+		fprintf(stderr, "%s: %s\n", path, e.what());
+		return 1;
+	}
+
+	snapshot.report(fptr);
+
+	return 0;
+}
+
 int main(int argc, char **argv)
 {
 	Table *table;
@@ -25,14 +98,197 @@ int main(int argc, char **argv)
 	// default player type is interactive player (playing on console)
 	const char *playerType = "interactive";
 
-	// if they provide a strategy type on the command line, let's
-	// use it
-	if(argc > 1)
-		playerType = argv[1];
+	// by default we play forever (until ^C) and dump statistics to the
+	// console as we go.  given a budget, we run in batch mode instead.
+	uint64_t maxHands = 0;
+	uint32_t maxSeconds = 0;
+	uint16_t threads = 0;
+	uint64_t seed = seed_portable();
+	const char *reportFile = NULL;
+	const char *snapshotFile = NULL;
+	const char *reduceFile = NULL;
+	const char *checkpointFile = NULL;
+	uint32_t checkpointInterval = 60;
+	bool resume = false;
+	const char *historyFile = NULL;
+	bool lazyShuffle = false;
+
+	// in reduce mode, the arguments are snapshots rather than a strategy
+	const char **inputs = new const char *[argc];
+	int inputCount = 0;
+
+	// parse the command line - options first, then the strategy type
+	for(int i = 1; i < argc; i++)
+	{
+		if(strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+			maxHands = strtoull(argv[++i], NULL, 10);
+
+		else if(strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+			maxSeconds = strtoul(argv[++i], NULL, 10);
+
+		else if(strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+			reportFile = argv[++i];
+
+		else if(strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+			threads = (uint16_t)strtoul(argv[++i], NULL, 10);
+
+		else if(strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+			seed = strtoull(argv[++i], NULL, 10);
+
+		else if(strcmp(argv[i], "-l") == 0)
+			lazyShuffle = true;
+
+		else if(strcmp(argv[i], "-w") == 0 && i + 1 < argc)
+			snapshotFile = argv[++i];
+
+		else if(strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+			reduceFile = argv[++i];
+
+		else if(strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+			checkpointFile = argv[++i];
+
+		else if(strcmp(argv[i], "-i") == 0 && i + 1 < argc)
+			checkpointInterval = strtoul(argv[++i], NULL, 10);
+
+		else if(strcmp(argv[i], "--resume") == 0)
+			resume = true;
+
+		else if(strcmp(argv[i], "-H") == 0 && i + 1 < argc)
+			historyFile = argv[++i];
+
+		else if(argv[i][0] == '-')
+		{
+			usage(stderr);
+			return 1;
+		}
+
+		// if they provide a strategy type on the command line, let's
+		// use it
+		else
+		{
+			playerType = argv[i];
+			inputs[inputCount++] = argv[i];
+		}
+	}
+
+	// in reduce mode, merge the snapshots and write the one report
+	if(reduceFile != NULL)
+	{
+		FILE *fptr = stdout;
+		int ret;
+
+		if(inputCount == 0)
+		{
+			usage(stderr);
+			return 1;
+		}
+
+		if(reportFile != NULL && (fptr = fopen(reportFile, "w")) == NULL)
+		{
+			fprintf(stderr, "Could not open %s for writing.\n", reportFile);
+			fptr = stdout;
+		}
+
+		ret = reduce(reduceFile, inputs, inputCount, fptr);
+
+		if(fptr != stdout)
+			fclose(fptr);
+
+		delete [] inputs;
+
+		return ret;
+	}
+
+	delete [] inputs;
+
+	// we can only resume from checkpoints
+	if(resume && checkpointFile == NULL)
+	{
+		usage(stderr);
+		return 1;
+	}
+
+	// in batch mode, run the shards in parallel and write the one and
+	// only report
+	if(maxHands > 0 || maxSeconds > 0)
+	{
+		Simulation *simulation;
+		FILE *fptr = stdout;
+
+		// the interactive player can only sit at one table
+		if(strcasecmp(playerType, "interactive") == 0)
+			threads = 1;
+
+		try {
+			simulation = new Simulation(playerType, threads, seed);
+		}
+		catch(...) {
+			fprintf(stderr, "Could not create %s player.  ", playerType);
+			fprintf(stderr, "Valid player types are:\n\n");
+
+			StrategyList(stderr);
+
+			fprintf(stderr, "\n");
+
+			return 1;
+		}
+
+		simulation->setLazyShuffle(lazyShuffle);
+
+		if(checkpointFile != NULL)
+			simulation->setCheckpoint(checkpointFile, checkpointInterval,
+			 resume);
+
+		if(historyFile != NULL)
+			simulation->setHistory(historyFile);
+
+		// finish the rounds in play and report on ^C or SIGTERM
+		CatchShutdownSignals();
+
+		if(!simulation->run(maxHands, maxSeconds))
+		{
+			delete simulation;
+			return 1;
+		}
+
+		if(ShutdownRequested())
+			fprintf(stderr, "Interrupted - reporting on the hands played so far.\n");
+
+		if(reportFile != NULL && (fptr = fopen(reportFile, "w")) == NULL)
+		{
+			fprintf(stderr, "Could not open %s for writing.\n", reportFile);
+			fptr = stdout;
+		}
+
+		simulation->report(fptr);
+
+		if(fptr != stdout)
+			fclose(fptr);
+
+		if(snapshotFile != NULL)
+		{
+			Snapshot snapshot;
+
+			simulation->snapshot(&snapshot);
+
+			try {
+				snapshot.write(snapshotFile);
+			}
+			catch(std::exception &e) {
+				fprintf(stderr, "%s: %s\n", snapshotFile, e.what());
+				delete simulation;
+				return 1;
+			}
+		}
+
+		delete simulation;
+
+		return 0;
+	}
 
 	// try to instantiate a table
 	try {
-		table = new Table();
+		table = new Table(seed);
 	}
 	catch(...) {
 		fprintf(stderr, "Could not instantiate table object.\n");
@@ -56,9 +312,39 @@ int main(int argc, char **argv)
 		return 1;
 	}
 
-	// run the table loop
+	if(lazyShuffle)
+		table->setLazyShuffle();
+
+	if(historyFile != NULL)
+	{
+		try {
+			table->setHistory(historyFile);
+		}
+		catch(std::exception &e) {
+			fprintf(stderr, "%s: %s.\n", historyFile, e.what());
+			delete table;
+			return 1;
+		}
+	}
+
+	// play until ^C (or SIGTERM), then write the final report
+	CatchShutdownSignals();
+
+	std::chrono::steady_clock::time_point start =
+	 std::chrono::steady_clock::now();
+
 	table->loop();
 
+	double elapsed = std::chrono::duration<double>(
+	 std::chrono::steady_clock::now() - start).count();
+
+	table->report(stdout);
+
+	fprintf(stdout,
+	 "      HANDS DEALT: %llu,  ELAPSED: %.2fs,  HANDS/SEC: %.0f\n",
+	 (unsigned long long)table->handsDealt(), elapsed,
+	 (elapsed > 0) ? (double)table->handsDealt() / elapsed : 0.0);
+
 	// teardown the table object
 	delete table;
 
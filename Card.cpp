@@ -21,6 +21,9 @@
 // Casino in Las Vegas: it allows a side bet paying 2:1 that your first
 // two cards will be of the same suit.  One might wish to analyze this
 // strategy.
+//
+// A card is a single byte - its index in a static table of the 52 cards
+// in a deck.  See Card.h.
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -36,71 +39,70 @@
 // see http://support.microsoft.com/default.aspx?scid=kb;EN-US;241569
 const uint8_t Card::suitCount = 4;
 const uint8_t Card::rankCount = 13;
+const uint8_t Card::deckCount;
 
 // define the ranks, suits of cards in a deck
 const char Card::suitList[] = { 'S', 'H', 'C', 'D' };
 const char Card::rankList[] = { 'A', '2', '3', '4', '5', '6', '7', '8',
 	'9', 'T', 'J', 'Q', 'K' };
 
+// the card table - every card in a deck, by suit, in the same order as
+// rankList.  each entry is: rank, suit, score, value, ace, ten, count
+// tag.  the count tag is the simple count (see StrategyCardCount): 3
+// through 7 are worth +1, tens and aces are worth -1.
+#define CARD_SUIT(s) \
+	{ 'A', s, 'A',  1, true,  false, -1 }, \
+	{ '2', s, '2',  2, false, false,  0 }, \
+	{ '3', s, '3',  3, false, false,  1 }, \
+	{ '4', s, '4',  4, false, false,  1 }, \
+	{ '5', s, '5',  5, false, false,  1 }, \
+	{ '6', s, '6',  6, false, false,  1 }, \
+	{ '7', s, '7',  7, false, false,  1 }, \
+	{ '8', s, '8',  8, false, false,  0 }, \
+	{ '9', s, '9',  9, false, false,  0 }, \
+	{ 'T', s, 'T', 10, false, true,  -1 }, \
+	{ 'J', s, 'T', 10, false, true,  -1 }, \
+	{ 'Q', s, 'T', 10, false, true,  -1 }, \
+	{ 'K', s, 'T', 10, false, true,  -1 }
+
+const Card::Info Card::_table[] = {
+	CARD_SUIT('S'),
+	CARD_SUIT('H'),
+	CARD_SUIT('C'),
+	CARD_SUIT('D'),
+
+	// "no card"
+	{ 0, 0, 0, 0, false, false, 0 }
+};
+
+#undef CARD_SUIT
+
 
 Card::Card(const char suit, const char rank)
 {
-	bool suitOk = false, rankOk = false;
+	int suitIdx = -1, rankIdx = -1;
 
 	// test input for validity
 	for(int i = 0; i < suitCount; i++)
 	{
 		if(suit == suitList[i])
-			suitOk = true;
+			suitIdx = i;
 	}
 
 	for(int j = 0; j < rankCount; j++)
 	{
 		if(rank == rankList[j])
-			rankOk = true;
+			rankIdx = j;
 	}
 
 	// throw exceptions on invalid input
-	if(suitOk == false)
+	if(suitIdx < 0)
 		throw std::invalid_argument("unknown suit");
 
-	if(rankOk == false)
+	if(rankIdx < 0)
 		throw std::invalid_argument("unknown rank");
 
-	_suit = suit;
-	_rank = rank;
-}
+	_code = (uint8_t)((suitIdx * rankCount) + rankIdx);
 
-// setWeight: weight accessor function
-void Card::setWeight(const int weight)
-{
-	_weight = weight;
+	ASSERT((_table[_code].suit == suit && _table[_code].rank == rank));
 }
-
-// getWeight: weight accessor function
-const int Card::getWeight()
-{
-	return _weight;
-}
-
-// getSuit: suit accessor function
-const char Card::getSuit()
-{
-	return _suit;
-}
-
-// getRank: rank accessor function
-const char Card::getRank()
-{
-	return _rank;
-}
-
-// getScore: like getRank(), but returns 'T' (ten) for any ten or face card
-const char Card::getScore()
-{
-	if(_rank == 'T' || _rank == 'J' || _rank == 'Q' || _rank == 'K')
-		return 'T';
-	else
-		return _rank;
-}
-
@@ -21,6 +21,13 @@
 // Casino in Las Vegas: it allows a side bet paying 2:1 that your first
 // two cards will be of the same suit.  One might wish to analyze this
 // strategy.
+//
+// A card is a single byte - its index in a static table of the 52 cards
+// in a deck - so a shoe is just an array of bytes and a card is passed
+// around by value.  Everything about a card (its rank, suit, blackjack
+// value, count tag, etc.) is precomputed in the table, so the accessors
+// are a single indexed load.  They're defined in this header so that
+// they can be inlined.
 
 #ifndef CARD_H
 #define CARD_H
@@ -31,24 +38,43 @@
 #include "Util.h"
 #include "Assert.h"
 
-// forward declaration to avoid circular dependencies
-class Shoe;
+//
+// class declaration
+//
 
 class Card
 {
 	public:
+		// the default card is "no card", which is returned by an
+		// empty LinkedList<Card>
+		Card();
 		Card(const char suit, const char rank);
 
-		// weight accessor functions
-		void setWeight(const int weight);
-		const int getWeight();
+		// is this a card (or "no card")
+		bool isValid() const;
 
 		// rank / suit accessor functions
-		const char getSuit();
-		const char getRank();
+		char getSuit() const;
+		char getRank() const;
 
 		// score is like rank, but returns 'T' (ten) for any ten or face
-		const char getScore();
+		char getScore() const;
+
+		// blackjack value of the card, counting an ace as 1
+		uint8_t getValue() const;
+
+		// is this an ace / a ten or face card
+		bool isAce() const;
+		bool isTen() const;
+
+		// card counting tag: +1 for 3-7, -1 for tens and aces
+		int8_t getCountTag() const;
+
+		// the single byte encoding of the card
+		uint8_t getCode() const;
+
+		bool operator==(const Card &card) const;
+		bool operator!=(const Card &card) const;
 
 		// list of ranks and suits, defined in Card.cpp
 		// we use a static member variable to avoid defining really
@@ -59,11 +85,105 @@ class Card
 		static const char rankList[];
 		static const uint8_t rankCount;
 
+		// number of cards in a deck
+		static const uint8_t deckCount = 52;
+
 
 	private:
-		char _suit;			// suit of the card ('S' = spades, etc.)
-		char _rank;			// rank of the card ('2', '3', 'A', etc.)
-		int _weight;		// weight for shuffling, see Shoe::shuffle()
+		// everything we know about a card, see Card.cpp
+		struct Info
+		{
+			char rank;			// rank of the card ('2', '3', 'A', etc.)
+			char suit;			// suit of the card ('S' = spades, etc.)
+			char score;			// rank, with 'T' for any ten or face
+			uint8_t value;		// blackjack value (ace is 1)
+			bool ace;			// card is an ace
+			bool ten;			// card is a ten or face
+			int8_t countTag;	// card counting tag
+		};
+
+		// one entry per card (suit-major, in rankList order) plus a
+		// final entry for "no card"
+		static const Info _table[];
+
+		uint8_t _code;		// index of the card in _table
 };
 
+
+//
+// inline function definition
+//
+
+// Card: the default constructor is "no card"
+inline Card::Card()
+{
+	_code = deckCount;
+}
+
+// isValid: returns false for "no card"
+inline bool Card::isValid() const
+{
+	return (_code < deckCount);
+}
+
+// getSuit: suit accessor function
+inline char Card::getSuit() const
+{
+	return _table[_code].suit;
+}
+
+// getRank: rank accessor function
+inline char Card::getRank() const
+{
+	return _table[_code].rank;
+}
+
+// getScore: like getRank(), but returns 'T' (ten) for any ten or face card
+inline char Card::getScore() const
+{
+	return _table[_code].score;
+}
+
+// getValue: returns the blackjack value of the card (ace is 1)
+inline uint8_t Card::getValue() const
+{
+	return _table[_code].value;
+}
+
+// isAce: returns true if the card is an ace
+inline bool Card::isAce() const
+{
+	return _table[_code].ace;
+}
+
+// isTen: returns true if the card is a ten or a face card
+inline bool Card::isTen() const
+{
+	return _table[_code].ten;
+}
+
+// getCountTag: returns the card counting tag for the card
+inline int8_t Card::getCountTag() const
+{
+	return _table[_code].countTag;
+}
+
+// getCode: returns the single byte encoding of the card
+inline uint8_t Card::getCode() const
+{
+	return _code;
+}
+
+// operator==: cards are the same card if they have the same code
+inline bool Card::operator==(const Card &card) const
+{
+	return (_code == card._code);
+}
+
+// operator!=: cards are different if they have different codes
+inline bool Card::operator!=(const Card &card) const
+{
+	return (_code != card._code);
+}
+
 #endif // CARD_H
@@ -0,0 +1,142 @@
+// Blackjack Simulation : CardList
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.  See the included file 'COPYING'
+// for more information.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// This is a list of the cards in a hand.  It has the same interface as
+// LinkedList<Card> (for the functions a hand needs), but the cards are
+// kept in a small array inside the list itself, so adding a card or
+// clearing the hand never allocates or frees memory.
+//
+// A hand can never hold more than maxCards cards: nobody may draw to a
+// hand of 21 or more, so every card but the last is drawn to a hard
+// total of at most 20.  Every card is worth at least 1, so that's at
+// most 20 cards plus the last one.
+//
+// Like LinkedList, iterate() returns each card in turn and then a
+// "no card" (Card::isValid() is false) at the end of the list, which
+// resets the cursor for the next iteration.
+
+#ifndef CARDLIST_H
+#define CARDLIST_H
+
+#include <stdlib.h>
+#include <sys/types.h>
+#include <stdint.h>
+#include "Util.h"
+#include "Assert.h"
+#include "Card.h"
+
+//
+// class declaration
+//
+
+class CardList
+{
+	public:
+		CardList();
+		Card iterate(void);				// walk through the list
+		bool addTail(Card card);		// add at tail of list
+		Card removeTail(void);			// remove tail item
+		Card fetchFront(void);			// return the front item
+		Card fetchTail(void);			// return the tail item
+		Card fetchNumber(uint16_t idx);	// return an indexed item (from 1)
+		uint32_t getCount(void);		// number of entries
+		void clear(void);				// clear the list
+
+		// most cards a hand can hold, see above
+		static const uint8_t maxCards = 21;
+
+	private:
+		Card _cards[maxCards];			// the cards, in the order added
+		uint8_t _count;					// # cards in the list
+		uint8_t _cursor;				// next card for iterate()
+};
+
+
+//
+// inline function definition
+//
+
+// constructor: sets up an empty list
+inline CardList::CardList()
+{
+	_count = 0;
+	_cursor = 0;
+}
+
+// iterate: returns the next card, and "no card" at the end of the list
+//          (which also resets the cursor to the front)
+inline Card CardList::iterate(void)
+{
+	if(_cursor < _count)
+		return _cards[_cursor++];
+
+	_cursor = 0;
+	return Card();
+}
+
+// addTail: add a card to the end of the list
+inline bool CardList::addTail(Card card)
+{
+	ASSERT(_count < maxCards);
+
+	_cards[_count++] = card;
+	return true;
+}
+
+// removeTail: remove and return the card at the end of the list, or
+//             "no card" if the list is empty
+inline Card CardList::removeTail(void)
+{
+	if(_count == 0)
+		return Card();
+
+	// don't leave the cursor past the end of the list
+	if(_cursor == _count)
+		_cursor--;
+
+	return _cards[--_count];
+}
+
+// fetchFront: returns the first card in the list, or "no card"
+inline Card CardList::fetchFront(void)
+{
+	return (_count > 0) ? _cards[0] : Card();
+}
+
+// fetchTail: returns the last card in the list, or "no card"
+inline Card CardList::fetchTail(void)
+{
+	return (_count > 0) ? _cards[_count - 1] : Card();
+}
+
+// fetchNumber: returns the idx'th card (the first card is 1, like
+//              LinkedList), or "no card"
+inline Card CardList::fetchNumber(uint16_t idx)
+{
+	return (idx > 0 && idx <= _count) ? _cards[idx - 1] : Card();
+}
+
+// getCount: returns the number of cards in the list
+inline uint32_t CardList::getCount(void)
+{
+	return _count;
+}
+
+// clear: empty the list
+inline void CardList::clear(void)
+{
+	_count = 0;
+	_cursor = 0;
+}
+
+#endif // CARDLIST_H
@@ -0,0 +1,242 @@
+// Blackjack Simulation : Checkpoint
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.  See the included file 'COPYING'
+// for more information.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// This is a checkpoint of a table in the middle of a run, and a writer
+// which writes them in the background.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <exception>
+#include <stdexcept>
+#include "Util.h"
+#include "Assert.h"
+#include "Checkpoint.h"
+#include "MappedFile.h"
+
+const char Checkpoint::magic[8] = { 'B', 'J', 'C', 'H', 'E', 'C', 'K', '\n' };
+
+Checkpoint::Checkpoint()
+{
+	_buffer = NULL;
+	_capacity = 0;
+
+	clear();
+}
+
+// write: add raw bytes to the end of the checkpoint
+void Checkpoint::write(const void *data, size_t size)
+{
+	reserve(_size + size);
+
+	memcpy(_buffer + _size, data, size);
+	_size += size;
+}
+
+// read: take the next raw bytes from the checkpoint
+void Checkpoint::read(void *data, size_t size)
+{
+	if(size > _size - _pos)
+		throw std::runtime_error("checkpoint is truncated");
+
+	memcpy(data, _buffer + _pos, size);
+	_pos += size;
+}
+
+// clear: empty the checkpoint (but keep the buffer, so that saving the
+//        next checkpoint doesn't allocate)
+void Checkpoint::clear()
+{
+	reserve(sizeof(Header));
+
+	_size = sizeof(Header);
+	_pos = sizeof(Header);
+}
+
+// save: fill in the header and write the whole buffer to the file
+void Checkpoint::save(const char *path)
+{
+	Header header;
+
+	memcpy(header.magic, magic, sizeof(header.magic));
+	header.version = version;
+	header.byteOrder = byteOrder;
+	header.size = _size - sizeof(Header);
+
+	memcpy(_buffer, &header, sizeof(Header));
+
+	if(!WriteFileAtomic(path, _buffer, _size))
+		throw std::runtime_error("could not write checkpoint");
+}
+
+// load: read the file into the buffer and check the header, ready to
+//       restore state from
+void Checkpoint::load(const char *path)
+{
+	Header header;
+	FILE *fptr;
+
+	if((fptr = fopen(path, "rb")) == NULL)
+		throw std::runtime_error("could not open checkpoint");
+
+	if(fread(&header, sizeof(Header), 1, fptr) != 1 ||
+	 memcmp(header.magic, magic, sizeof(header.magic)) != 0)
+	{
+		fclose(fptr);
+		throw std::runtime_error("not a checkpoint");
+	}
+
+	if(header.byteOrder != byteOrder || header.version != version)
+	{
+		fclose(fptr);
+		throw std::runtime_error("checkpoint is from a different version");
+	}
+
+	clear();
+	reserve(sizeof(Header) + header.size);
+
+	if(fread(_buffer + sizeof(Header), 1, header.size, fptr) != header.size)
+	{
+		fclose(fptr);
+		throw std::runtime_error("checkpoint is truncated");
+	}
+
+	fclose(fptr);
+
+	memcpy(_buffer, &header, sizeof(Header));
+	_size = sizeof(Header) + header.size;
+}
+
+// reserve: make sure the buffer can hold at least size bytes
+void Checkpoint::reserve(size_t size)
+{
+	if(size <= _capacity)
+		return;
+
+	size_t capacity = (_capacity > 0) ? _capacity : 4096;
+
+	while(capacity < size)
+		capacity *= 2;
+
+	uint8_t *buffer = new uint8_t[capacity];
+
+	if(_buffer != NULL)
+	{
+		memcpy(buffer, _buffer, _size);
+		delete [] _buffer;
+	}
+
+	_buffer = buffer;
+	_capacity = capacity;
+}
+
+Checkpoint::~Checkpoint()
+{
+	delete [] _buffer;
+}
+
+
+CheckpointWriter::CheckpointWriter(const char *path) : _busy(false)
+{
+	ASSERT(path != NULL);
+
+	_path = new char[strlen(path) + 1];
+	strcpy(_path, path);
+
+	_pending = false;
+	_stop = false;
+
+	_thread = new std::thread(run, this);
+}
+
+// begin: returns the checkpoint to save state into, unless the last one
+//        is still being written
+Checkpoint *CheckpointWriter::begin()
+{
+	if(_busy.load())
+		return NULL;
+
+	_checkpoint.clear();
+
+	return &_checkpoint;
+}
+
+// commit: hand the checkpoint to the writer thread
+void CheckpointWriter::commit()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	_busy.store(true);
+	_pending = true;
+
+	_cond.notify_all();
+}
+
+// wait: wait for the writer thread to finish writing
+void CheckpointWriter::wait()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+
+	while(_busy.load())
+		_cond.wait(lock);
+}
+
+// run: the writer thread - write each checkpoint as it's committed
+void CheckpointWriter::run(CheckpointWriter *writer)
+{
+	std::unique_lock<std::mutex> lock(writer->_mutex);
+
+	while(true)
+	{
+		while(!writer->_pending && !writer->_stop)
+			writer->_cond.wait(lock);
+
+		if(!writer->_pending)
+			break;
+
+		writer->_pending = false;
+
+		// nobody touches the checkpoint while it's busy, so we can
+		// let go of the lock while we're on the disk
+		lock.unlock();
+
+		try {
+			writer->_checkpoint.save(writer->_path);
+		}
+		catch(std::exception &e) {
+			fprintf(stderr, "%s: %s\n", writer->_path, e.what());
+		}
+
+		lock.lock();
+
+		writer->_busy.store(false);
+		writer->_cond.notify_all();
+	}
+}
+
+CheckpointWriter::~CheckpointWriter()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		_stop = true;
+		_cond.notify_all();
+	}
+
+	// the thread writes anything still pending before it exits
+	_thread->join();
+
+	delete _thread;
+	delete [] _path;
+}
@@ -0,0 +1,143 @@
+// Blackjack Simulation : Checkpoint
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.  See the included file 'COPYING'
+// for more information.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// This is a checkpoint of a table in the middle of a run - everything
+// needed to carry on exactly where it left off: the shoe (cards, deal
+// position and random number generator), the hand counts, and each
+// player's totals, statistics and strategy state.  A resumed table
+// deals and plays exactly as it would have if it had never stopped.
+//
+// A checkpoint is just a buffer that each part of the table saves its
+// state into (with put()) and restores it from (with get(), in the same
+// order.)  It's written to disk with a small header, in the byte order
+// of the machine that wrote it, and only a machine of the same kind
+// (and the same version of the program) can resume from it.
+//
+// A CheckpointWriter writes checkpoints on its own thread, so that a
+// table never waits on the disk: the table fills the writer's buffer
+// when it's idle and goes back to playing while it's written.
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "Util.h"
+#include "Assert.h"
+
+class Checkpoint
+{
+	public:
+		static const char magic[8];
+		static const uint32_t version = 1;
+		static const uint32_t byteOrder = 0x01020304;
+
+		// an empty checkpoint, ready to save state into
+		Checkpoint();
+
+		// add raw bytes to the checkpoint, or take the next ones out
+		// - read() throws std::runtime_error if there aren't enough
+		void write(const void *data, size_t size);
+		void read(void *data, size_t size);
+
+		// save or restore a single value
+		template <class T> void put(const T &value);
+		template <class T> void get(T &value);
+
+		// empty the checkpoint, ready to save state into again
+		void clear();
+
+		// write the checkpoint to the file at path (atomically, see
+		// MappedFile.h), or read it back - throws std::runtime_error
+		// if it can't be written or read
+		void save(const char *path);
+		void load(const char *path);
+
+		~Checkpoint();
+
+	private:
+		// the header at the front of the buffer (and the file)
+		struct Header
+		{
+			char magic[8];
+			uint32_t version;
+			uint32_t byteOrder;
+			uint64_t size;
+		};
+
+		void reserve(size_t size);
+
+		uint8_t *_buffer;				// header, then the state
+		size_t _size;					// bytes used in the buffer
+		size_t _capacity;				// bytes allocated
+		size_t _pos;					// next byte to read
+};
+
+class CheckpointWriter
+{
+	public:
+		// write checkpoints to the file at path
+		CheckpointWriter(const char *path);
+
+		// returns an empty checkpoint to save state into, or NULL
+		// if the last checkpoint is still being written.  never
+		// waits.
+		Checkpoint *begin();
+
+		// write the checkpoint from begin() in the background
+		void commit();
+
+		// wait for the checkpoint being written (if any) to finish
+		void wait();
+
+		~CheckpointWriter();
+
+	private:
+		static void run(CheckpointWriter *writer);
+
+		char *_path;					// file to write to
+		Checkpoint _checkpoint;			// checkpoint to write
+		std::atomic<bool> _busy;		// _checkpoint is being written
+		bool _pending;					// commit() is waiting to write
+		bool _stop;						// the thread should exit
+		std::mutex _mutex;				// protects _pending and _stop
+		std::condition_variable _cond;	// signals _pending, _stop, !_busy
+		std::thread *_thread;			// the writer thread
+};
+
+
+//
+// inline function definition
+//
+
+// put: save a single value (of a plain type) in the checkpoint
+template <class T>
+inline void Checkpoint::put(const T &value)
+{
+	write(&value, sizeof(value));
+}
+
+// get: restore a single value (of a plain type) from the checkpoint
+template <class T>
+inline void Checkpoint::get(T &value)
+{
+	read(&value, sizeof(value));
+}
+
+#endif // CHECKPOINT_H
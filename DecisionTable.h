@@ -0,0 +1,437 @@
+// Blackjack Simulation : DecisionTable
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.  See the included file 'COPYING'
+// for more information.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// This is a playing strategy compiled into a table of actions.  The
+// table is indexed by the class of the hand (hard, soft or a pair), the
+// hand's total (or the value of the paired card), the dealer's up card,
+// and whether the hand may still double (only on the first two cards),
+// so deciding how to play a hand is a single lookup.
+//
+// A table is built from a chart, written the way strategy charts are
+// usually printed.  Each line is a hand, then a colon, then the action
+// against each dealer up card, 2 through 10 and then Ace:
+//
+//     # hard totals
+//     12:   H  H  S  S  S  H  H  H  H  H
+//     # soft totals (an ace and another card)
+//     A,7:  S  Ds Ds Ds Ds S  S  H  H  H
+//     # pairs
+//     8,8:  P  P  P  P  P  P  P  P  P  P
+//
+// The actions are H (hit), S (stand), P (split, pairs only), Dh (double
+// if allowed, otherwise hit) and Ds (double if allowed, otherwise stand.)
+// A '#' starts a comment.  A chart must give every hard total from 5 to
+// 20, every soft total from A,2 to A,9 and every pair from 2,2 to A,A
+// (hard 21 and A,10 may be given, but are never played.)  Tens are 10
+// or T, aces are A.
+//
+// A cell may also deviate from the chart by the true count: "H/S@2"
+// means hit, but stand when the true count is +2 or more.  ("S/H@-1"
+// would be stand, but hit at -1 or more - so to hit *below* -1, write
+// "H/S@-1".)  The deviation is flagged in the cell, so hands without
+// one cost no more to look up.
+//
+// The constructor is constexpr, so a chart that's built into the program
+// is compiled into its table by the compiler.  A bad chart throws
+// std::invalid_argument (which, for a constexpr table, is a compile
+// error) - if errorLine is given, it's set to the line that was bad (or
+// zero if the chart is missing a hand.)
+
+#ifndef DECISIONTABLE_H
+#define DECISIONTABLE_H
+
+#include <stdlib.h>
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdexcept>
+#include "Util.h"
+#include "Assert.h"
+#include "Strategy.h"
+#include "Hand.h"
+
+//
+// class declaration
+//
+
+class DecisionTable
+{
+	public:
+		// classes of hand, the first index into the table
+		enum HandClass { Hard = 0, Soft = 1, Pair = 2 };
+
+		// compile a chart (see above) into a table
+		constexpr DecisionTable(const char *chart,
+		 size_t *errorLine = NULL);
+
+		// the action for a hand against the dealer's showing hand, at
+		// the given true count
+		PlayAction lookup(Hand *hand, Hand *dealer,
+		 float trueCount = 0) const;
+
+		// the action for a class of hand and total (the value of the
+		// paired card for pairs, ace is 1), the dealer's up card (2 to
+		// 11, ace is 11) and whether the hand may double, ignoring
+		// any deviation
+		constexpr PlayAction getAction(HandClass handClass, uint8_t total,
+		 uint8_t upCard, bool canDouble) const;
+
+		// true if any cell deviates by the count
+		constexpr bool hasDeviations() const;
+
+	private:
+		// actions as they're written in the chart
+		enum ChartAction { ChartHit, ChartStand, ChartSplit,
+		 ChartDoubleHit, ChartDoubleStand };
+
+		// a cell with a deviation has this bit set on its action
+		static const uint8_t deviationFlag = 0x80;
+
+		// chart parsing
+		static constexpr bool isBlank(char c);
+		static constexpr bool isEnd(char c);
+		static constexpr void skipBlanks(const char *chart, size_t &pos);
+		static constexpr uint8_t parseCard(const char *chart, size_t &pos);
+		static constexpr int8_t parseIndex(const char *chart, size_t &pos);
+		static constexpr ChartAction parseAction(const char *chart,
+		 size_t &pos, bool isPair);
+		static constexpr uint8_t resolve(ChartAction action,
+		 bool canDouble);
+
+		// the actions (PlayAction values), by [class][total][up card]
+		// [can double], with deviationFlag set for cells that deviate
+		uint8_t _actions[3][22][12][2];
+
+		// for cells that deviate, the action to take instead and the
+		// true count to take it at
+		uint8_t _deviations[3][22][12][2];
+		int8_t _indexes[3][22][12];
+
+		bool _hasDeviations;
+};
+
+
+//
+// inline function definition
+//
+
+// constructor: parse each line of the chart into the table, and make
+//              sure that every hand we need was given
+constexpr DecisionTable::DecisionTable(const char *chart, size_t *errorLine)
+ : _actions(), _deviations(), _indexes(), _hasDeviations(false)
+{
+	bool seen[3][22] = { };
+	size_t pos = 0;
+	size_t line = 0;
+
+	while(chart[pos] != '\0')
+	{
+		HandClass handClass = Hard;
+		uint8_t total = 0;
+
+		if(errorLine != NULL)
+			*errorLine = ++line;
+
+		skipBlanks(chart, pos);
+
+		// skip comments and blank lines
+		if(chart[pos] == '#')
+		{
+			while(chart[pos] != '\0' && chart[pos] != '\n')
+				pos++;
+		}
+
+		if(chart[pos] == '\n')
+		{
+			pos++;
+			continue;
+		}
+		else if(chart[pos] == '\0')
+			break;
+
+		// the hand: a hard total, "A,x" for a soft total or "x,x"
+		// for a pair
+		uint8_t card1 = parseCard(chart, pos);
+
+		if(chart[pos] == ',')
+		{
+			pos++;
+
+			uint8_t card2 = parseCard(chart, pos);
+
+			if(card1 == card2 && card1 <= 10)
+			{
+				handClass = Pair;
+				total = card1;
+			}
+			else if(card1 == 1 && card2 >= 2 && card2 <= 10)
+			{
+				handClass = Soft;
+				total = 11 + card2;
+			}
+			else
+				throw std::invalid_argument("unknown hand");
+		}
+		else if(card1 >= 4 && card1 <= 21)
+			total = card1;
+		else
+			throw std::invalid_argument("unknown hand");
+
+		if(seen[handClass][total])
+			throw std::invalid_argument("hand given twice");
+
+		seen[handClass][total] = true;
+
+		skipBlanks(chart, pos);
+
+		if(chart[pos] != ':')
+			throw std::invalid_argument("expected ':' after the hand");
+
+		pos++;
+
+		// the action against each up card, 2 - 10 and then the ace
+		for(uint8_t upCard = 2; upCard <= 11; upCard++)
+		{
+			skipBlanks(chart, pos);
+
+			ChartAction action = parseAction(chart, pos, handClass == Pair);
+
+			_actions[handClass][total][upCard][0] = resolve(action, false);
+			_actions[handClass][total][upCard][1] = resolve(action, true);
+
+			// a deviation - "/", the other action, "@" and the index
+			if(chart[pos] == '/')
+			{
+				pos++;
+
+				ChartAction deviation =
+				 parseAction(chart, pos, handClass == Pair);
+
+				if(chart[pos] != '@')
+					throw std::invalid_argument("expected '@' and an index");
+
+				pos++;
+
+				_indexes[handClass][total][upCard] = parseIndex(chart, pos);
+
+				_deviations[handClass][total][upCard][0] =
+				 resolve(deviation, false);
+				_deviations[handClass][total][upCard][1] =
+				 resolve(deviation, true);
+
+				_actions[handClass][total][upCard][0] |= deviationFlag;
+				_actions[handClass][total][upCard][1] |= deviationFlag;
+
+				_hasDeviations = true;
+			}
+
+			if(!isBlank(chart[pos]) && !isEnd(chart[pos]))
+				throw std::invalid_argument("unknown action");
+		}
+
+		skipBlanks(chart, pos);
+
+		if(!isEnd(chart[pos]))
+			throw std::invalid_argument("too many actions");
+
+		// skip any comment to the next line
+		while(chart[pos] != '\0' && chart[pos] != '\n')
+			pos++;
+
+		if(chart[pos] == '\n')
+			pos++;
+	}
+
+	if(errorLine != NULL)
+		*errorLine = 0;
+
+	for(uint8_t total = 5; total <= 20; total++)
+	{
+		if(!seen[Hard][total])
+			throw std::invalid_argument("missing a hard total");
+	}
+
+	for(uint8_t total = 13; total <= 20; total++)
+	{
+		if(!seen[Soft][total])
+			throw std::invalid_argument("missing a soft total");
+	}
+
+	for(uint8_t card = 1; card <= 10; card++)
+	{
+		if(!seen[Pair][card])
+			throw std::invalid_argument("missing a pair");
+	}
+}
+
+// lookup: returns the action for a hand against the dealer's showing
+//         hand (the up card), at the given true count
+inline PlayAction DecisionTable::lookup(Hand *hand, Hand *dealer,
+ float trueCount) const
+{
+	HandClass handClass = Hard;
+	uint8_t total = hand->getScore();
+	uint8_t upCard = dealer->getScore();
+	bool canDouble = (hand->getCardCount() == 2);
+
+	if(hand->splitAllowed())
+	{
+		handClass = Pair;
+		total = hand->getCards()->fetchFront().getValue();
+	}
+	else if(hand->getSoft())
+		handClass = Soft;
+
+	ASSERT(total <= 21);
+	ASSERT(dealer->getCardCount() == 1);
+
+	uint8_t action = _actions[handClass][total][upCard][canDouble];
+
+	if((action & deviationFlag) &&
+	 trueCount >= _indexes[handClass][total][upCard])
+		return (PlayAction)_deviations[handClass][total][upCard][canDouble];
+
+	return (PlayAction)(action & ~deviationFlag);
+}
+
+// getAction: returns the action for a class of hand, total, up card and
+//            whether the hand may double (None if the chart doesn't
+//            cover that hand), ignoring any deviation
+constexpr PlayAction DecisionTable::getAction(HandClass handClass,
+ uint8_t total, uint8_t upCard, bool canDouble) const
+{
+	return (PlayAction)
+	 (_actions[handClass][total][upCard][canDouble] & ~deviationFlag);
+}
+
+// hasDeviations: returns true if any cell deviates by the count, so the
+//                player needs to keep one
+constexpr bool DecisionTable::hasDeviations() const
+{
+	return _hasDeviations;
+}
+
+// isBlank: spaces and tabs separate the actions on a line
+constexpr bool DecisionTable::isBlank(char c)
+{
+	return (c == ' ' || c == '\t' || c == '\r');
+}
+
+// isEnd: the end of a line (or of the chart, or a comment)
+constexpr bool DecisionTable::isEnd(char c)
+{
+	return (c == '\0' || c == '\n' || c == '#');
+}
+
+// skipBlanks: move past any spaces or tabs
+constexpr void DecisionTable::skipBlanks(const char *chart, size_t &pos)
+{
+	while(isBlank(chart[pos]))
+		pos++;
+}
+
+// parseCard: parse a card (A, T, or a number) in a hand - returns its
+//            value, with the ace as 1
+constexpr uint8_t DecisionTable::parseCard(const char *chart, size_t &pos)
+{
+	uint8_t value = 0;
+
+	if(chart[pos] == 'A')
+	{
+		pos++;
+		return 1;
+	}
+	else if(chart[pos] == 'T')
+	{
+		pos++;
+		return 10;
+	}
+
+	while(chart[pos] >= '0' && chart[pos] <= '9' && value <= 21)
+		value = (uint8_t)((value * 10) + (chart[pos++] - '0'));
+
+	if(value == 0 || value > 21)
+		throw std::invalid_argument("unknown card");
+
+	return value;
+}
+
+// parseIndex: parse a deviation's true count index, eg "+2", "0", "-1"
+constexpr int8_t DecisionTable::parseIndex(const char *chart, size_t &pos)
+{
+	bool negative = false;
+	int16_t index = 0;
+
+	if(chart[pos] == '+' || chart[pos] == '-')
+		negative = (chart[pos++] == '-');
+
+	if(chart[pos] < '0' || chart[pos] > '9')
+		throw std::invalid_argument("expected a true count index");
+
+	while(chart[pos] >= '0' && chart[pos] <= '9' && index <= 100)
+		index = (int16_t)((index * 10) + (chart[pos++] - '0'));
+
+	if(index > 100)
+		throw std::invalid_argument("true count index out of range");
+
+	return (int8_t)(negative ? -index : index);
+}
+
+// parseAction: parse an action as written in the chart
+constexpr DecisionTable::ChartAction DecisionTable::parseAction(
+ const char *chart, size_t &pos, bool isPair)
+{
+	if(isBlank(chart[pos]) || isEnd(chart[pos]))
+		throw std::invalid_argument("too few actions");
+
+	char action = chart[pos++];
+	char modifier = 0;
+
+	if(chart[pos] == 'h' || chart[pos] == 's')
+		modifier = chart[pos++];
+
+	if(action == 'H' && modifier == 0)
+		return ChartHit;
+	else if(action == 'S' && modifier == 0)
+		return ChartStand;
+	else if(action == 'P' && modifier == 0 && isPair)
+		return ChartSplit;
+	else if(action == 'D' && modifier == 'h')
+		return ChartDoubleHit;
+	else if(action == 'D' && modifier == 's')
+		return ChartDoubleStand;
+
+	throw std::invalid_argument("unknown action");
+}
+
+// resolve: returns what to do for an action in the chart - whether the
+//          hand may double decides what "Dh" and "Ds" mean
+constexpr uint8_t DecisionTable::resolve(ChartAction action, bool canDouble)
+{
+	switch(action)
+	{
+		case ChartHit:
+			return Hit;
+		case ChartStand:
+			return Stand;
+		case ChartSplit:
+			return Split;
+		case ChartDoubleHit:
+			return canDouble ? Double : Hit;
+		case ChartDoubleStand:
+			return canDouble ? Double : Stand;
+	}
+
+	return None;
+}
+
+#endif // DECISIONTABLE_H
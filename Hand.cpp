@@ -12,21 +12,29 @@
 // GNU General Public License for more details.
 //
 // This is a hand -- it contains a list of cards (ie, the hand) and
-// a bet for that hand.
+// a bet for that hand.  The hand's score is kept up to date as cards
+// are added, see Hand.h
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <sys/types.h>
 #include "Util.h"
 #include "Assert.h"
-#include "LinkedList.h"
 #include "Card.h"
+#include "CardList.h"
 #include "Hand.h"
 
 Hand::Hand(bool isSplit)
 {
-	// create a card list for this hand
-	_cards = new LinkedList<Card *>;
+	reset(isSplit);
+}
+
+// reset: empty the hand and reset everything about it, as if it were
+//        a newly constructed hand
+void Hand::reset(bool isSplit)
+{
+	// the hand starts out with no cards
+	clear();
 
 	// setup some defaults
 	_bet = 0;
@@ -38,133 +46,89 @@ Hand::Hand(bool isSplit)
 }
 
 // getCards: card accessor function
-LinkedList<Card *> *Hand::getCards()
+CardList *Hand::getCards()
+{
+	return &_cards;
+}
+
+// addCard: add a card to the end of the hand and update the totals
+void Hand::addCard(Card card)
+{
+	ASSERT(card.isValid());
+
+	_cards.addTail(card);
+
+	_hard += card.getValue();
+
+	if(card.isAce())
+		_aces++;
+
+	// you may split tens of any type (so 10/K is a pair), otherwise
+	// they must have the same rank.  the value is the same either way.
+	_pair = (_cards.getCount() == 2 &&
+	 _cards.fetchFront().getValue() == card.getValue());
+}
+
+// removeCard: remove the last card from the hand (ie, when splitting)
+//             and update the totals
+Card Hand::removeCard()
 {
-	return _cards;
+	Card card = _cards.removeTail();
+
+	ASSERT(card.isValid());
+
+	_hard -= card.getValue();
+
+	if(card.isAce())
+		_aces--;
+
+	// a pair needs two cards, and there's at most one left
+	_pair = false;
+
+	return card;
+}
+
+// clear: remove all the cards from the hand
+void Hand::clear()
+{
+	_cards.clear();
+
+	_hard = 0;
+	_aces = 0;
+	_pair = false;
 }
 
 // getScore: return the score of the current hand, ie 10/6 returns 16,
 //           Ace/6 returns 17
 uint8_t Hand::getScore()
 {
-	// call the static getScore function
-	return getScore(_cards);
+	// aces are worth 1 or 11 - we've counted them all as 1.  only one
+	// ace can ever be worth 11 (two would be 22), so if that doesn't
+	// bust the hand, count it.
+	if(_aces > 0 && _hard + 10 <= 21)
+		return _hard + 10;
+
+	return _hard;
 }
 
 // getSoft: return the "softness" of the current hand, ie Ace/6 would
 //          return true, Ace/10/6 would return false
 bool Hand::getSoft()
 {
-	return getSoft(_cards);
+	return (_aces > 0 && _hard + 10 <= 21);
 }
 
 // splitAllowed: returns true on a pair of the same cards (8/8 or 10/10)
 //               and false on a non-splittable hand (eg 5/6)
 bool Hand::splitAllowed()
 {
-	return splitAllowed(_cards);
-}
-
-// getScore: determines the score of the hand
-uint8_t Hand::getScore(LinkedList<Card *> *cards, bool *soft)
-{
-	Card *card = NULL;
-	uint8_t score = 0;
-	uint8_t aces = 0;
-
-	// examine each card in the hand
-	while((card = cards->iterate()) != NULL)
-	{
-		// get the rank
-		char cardRank = card->getRank();
-
-		// face cards are worth ten points
-		if(
-			cardRank == 'T' || cardRank == 'J' ||
-			cardRank == 'Q' || cardRank == 'K'
-		)
-		{
-			score += 10;
-		}
-
-		// aces are worth 1 or 11 - we assume 11 for now and keep a
-		// count of the number of aces - if we would bust, we'll treat
-		// them as a 1 instead.
-		else if(cardRank == 'A')
-		{
-			score += 11;
-			aces++;
-		}
-
-		// otherwise, just get the score of the card
-		else
-		{
-			// since this is a char type, its value is the ASCII value of the
-			// character code.  subtracting 48 will give us this in decimal
-			score += (cardRank - 48);
-		}
-	}
-
-	// up to now, we counted all the aces as 11 points.  if we're over
-	// 21 points and we have a "soft" hand (ie, we've used an ace) then
-	// we want to instead count those aces as 1.  so as long as we're over
-	// 21, we subtract 10 off for each ace in our hand.
-	while(score > 21 && aces > 0)
-	{
-		score -= 10;
-		aces--;
-	}
-
-	// assign to the soft boolean if it was provided (typically by
-	// getSoft, below)
-	if(soft != NULL)
-		*soft = (aces > 0) ? true : false;
-
-	return score;
-}
-
-// getSoft: returns true if the hand is a soft hand (ie, Ace/6)
-bool Hand::getSoft(LinkedList<Card *> *cards)
-{
-	bool soft;
-
-	// let getScore do all the work rather than reimplementing it
-	getScore(cards, &soft);
-
-	return soft;
-}
-
-// splitAllowed: returns true if this hand may be split (ie, only
-//               two cards of the same rank)
-bool Hand::splitAllowed(LinkedList<Card *> *cards)
-{
-	// can only split on the initial deal (two cards)
-	if(cards->getCount() != 2)
-		return false;
-
-	// get the two cards
-	Card *firstCard = cards->fetchFront();
-	Card *lastCard = cards->fetchTail();
-
-	// get the rank of the two cards
-	char firstRank = firstCard->getRank();
-	char lastRank = lastCard->getRank();
-
-	// you may split tens of any type
-	if(
-		firstRank == 'T' || firstRank == 'J' ||
-		firstRank == 'Q' || firstRank == 'K'
-	)
-	{
-		return((
-			lastRank == 'T' || lastRank == 'J' ||
-			lastRank == 'Q' || lastRank == 'K'
-		) ? true : false);
-	}
-
-	// otherwise, they must have the same rank
-	else
-		return ((firstRank == lastRank) ? true : false);
+	return _pair;
+}
+
+// getCardCount: returns the number of cards in the hand
+uint8_t Hand::getCardCount()
+{
+	return (uint8_t)_cards.getCount();
 }
 
 // setBet: set the bet for this hand (strategy sets the bet)
@@ -241,6 +205,5 @@ bool Hand::isSplitHand()
 
 Hand::~Hand()
 {
-	delete _cards;
 }
 
@@ -13,6 +13,13 @@
 //
 // This is a hand -- it contains a list of cards (ie, the hand) and
 // a bet for that hand.
+//
+// The hand keeps a running total as cards are added to it (the score
+// with every ace counted as 1, the number of aces, and whether the first
+// two cards are a pair), so the score, softness and split queries are
+// constant time no matter how often they're asked.  Cards must only be
+// added or removed with addCard() and removeCard() to keep the totals
+// in step - the card list itself is for looking at.
 
 
 
@@ -26,8 +33,8 @@
 #include <sys/types.h>
 #include "Util.h"
 #include "Assert.h"
-#include "LinkedList.h"
 #include "Card.h"
+#include "CardList.h"
 
 
 typedef enum { Loss = 0, Push = 1, Win = 2 } HandOutcome;
@@ -37,7 +44,18 @@ class Hand
 {
 	public:
 		Hand(bool isSplit = false);
-		LinkedList<Card *> *getCards();
+
+		// empty the hand and reset it for a new round, so that the
+		// hand object can be reused
+		void reset(bool isSplit = false);
+		CardList *getCards();
+
+		// add a card to (or remove the last card from) the hand
+		void addCard(Card card);
+		Card removeCard();
+
+		// remove all the cards from the hand
+		void clear();
 
 		// get the hand score, softness (ie, ace 6 is "soft 17")
 		// and whether split is allowed (ie, two matching cards)
@@ -45,13 +63,8 @@ class Hand
 		bool getSoft();
 		bool splitAllowed();
 
-		// static versions of the same for use when you don't have
-		// a hand object (like the dealer obj) just a linked list of
-		// cards
-		static uint8_t getScore(LinkedList<Card *> *cards,
-		 bool *soft = NULL);
-		static bool getSoft(LinkedList<Card *> *cards);
-		static bool splitAllowed(LinkedList<Card *> *cards);
+		// number of cards in the hand
+		uint8_t getCardCount();
 
 		// bet amount accessors
 		void setBet(uint8_t bet);
@@ -78,7 +91,10 @@ class Hand
 
 
 	private:
-		LinkedList<Card *> *_cards;	// card list (the hand)
+		CardList _cards;			// card list (the hand)
+		uint8_t _hard;				// total, counting aces as 1
+		uint8_t _aces;				// number of aces in the hand
+		bool _pair;					// first two cards are a pair
 		uint8_t _bet;				// bet for this hand
 		bool _betInsurance;			// this hand is insured
 		bool _blackjack;			// hand is blackjack (Ace + 10 card)
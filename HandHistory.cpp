@@ -0,0 +1,185 @@
+// Blackjack Simulation : HandHistory
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.  See the included file 'COPYING'
+// for more information.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// This is a hand history, a compact binary log of every round played
+// at a table.  See HandHistory.h for the format.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <exception>
+#include <stdexcept>
+#include <chrono>
+#include "Util.h"
+#include "Assert.h"
+#include "HandHistory.h"
+#include "Player.h"
+
+const char HandHistory::magic[8] = { 'B', 'J', 'H', 'I', 'S', 'T', '\r', '\n' };
+
+HandHistory::HandHistory(const char *path, uint64_t seed, uint32_t stream,
+ uint64_t firstRound, bool append) : _head(0), _published(0), _stop(false)
+{
+	Header header;
+
+	ASSERT(path != NULL);
+	ASSERT(Card::rankCount == rankCount);
+
+	if((_fptr = fopen(path, append ? "ab" : "wb")) == NULL)
+		throw std::runtime_error("could not open hand history");
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, magic, sizeof(header.magic));
+	header.version = version;
+	header.stream = stream;
+	header.seed = seed;
+	header.firstRound = firstRound;
+
+	if(fwrite(&header, sizeof(header), 1, _fptr) != 1)
+	{
+		fclose(_fptr);
+		throw std::runtime_error("could not write hand history");
+	}
+
+	_buffer = new uint8_t[bufferSize];
+	_tail = 0;
+	_headCache = 0;
+
+	_handCount = 0;
+	_seatCount = 0;
+	_target = NULL;
+	_targeted = false;
+
+	_thread = new std::thread(run, this);
+}
+
+// beginRound: start a round - make sure there's room in the buffer for
+//             anything the round could log, waiting for the writer if
+//             we have to
+void HandHistory::beginRound(uint16_t cardsLeft, bool shuffled)
+{
+	while(_tail + maxRoundSize - _headCache > bufferSize)
+	{
+		_headCache = _head.load(std::memory_order_acquire);
+
+		if(_tail + maxRoundSize - _headCache > bufferSize)
+			std::this_thread::yield();
+	}
+
+	_handCount = 0;
+	_seatCount = 0;
+	_target = NULL;
+	_targeted = false;
+
+	putEvent(RoundEvent, shuffled ? 1 : 0);
+	putVarint(cardsLeft);
+}
+
+// endRound: hand the round to the writer
+void HandHistory::endRound()
+{
+	ASSERT(_tail - _published.load(std::memory_order_relaxed) <= maxRoundSize);
+
+	_published.store(_tail, std::memory_order_release);
+}
+
+// retarget: make the following events for a different hand (NULL for
+//           the dealer), numbering the hand if it's new in this round
+void HandHistory::retarget(Player *player, Hand *hand)
+{
+	uint8_t i, seat;
+
+	_target = hand;
+	_targeted = true;
+
+	if(hand == NULL)
+	{
+		putEvent(DealerEvent, 0);
+		return;
+	}
+
+	for(i = 0; i < _handCount; i++)
+	{
+		if(_hands[i] == hand)
+		{
+			putEvent(HandEvent, i);
+			return;
+		}
+	}
+
+	for(seat = 0; seat < _seatCount; seat++)
+	{
+		if(_seats[seat] == player)
+			break;
+	}
+
+	ASSERT(_handCount < maxHands);
+
+	if(seat == _seatCount)
+		_seats[_seatCount++] = player;
+
+	_hands[_handCount++] = hand;
+	putEvent(NewHandEvent, seat);
+}
+
+// run: the writer thread - every millisecond, write whatever whole
+//      rounds have been published since last time, until we're stopped
+//      (and everything that was published has been written.)  writing
+//      in batches rather than as each round comes in keeps the thread
+//      from competing with the table for the processor.
+void HandHistory::run(HandHistory *history)
+{
+	size_t head = history->_head.load(std::memory_order_relaxed);
+
+	while(true)
+	{
+		// check for stop first, so that we drain everything that
+		// was published before it was set
+		bool stop = history->_stop.load(std::memory_order_acquire);
+		size_t published = history->_published.load(std::memory_order_acquire);
+
+		// write up to the end of the ring, then around to the start
+		while(head != published)
+		{
+			size_t start = head & (bufferSize - 1);
+			size_t len = published - head;
+
+			if(len > bufferSize - start)
+				len = bufferSize - start;
+
+			fwrite(history->_buffer + start, 1, len, history->_fptr);
+			head += len;
+		}
+
+		history->_head.store(head, std::memory_order_release);
+
+		if(stop)
+			break;
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+}
+
+HandHistory::~HandHistory()
+{
+	_stop.store(true, std::memory_order_release);
+
+	_thread->join();
+
+	if(fclose(_fptr) != 0)
+		fprintf(stderr, "Could not write hand history.\n");
+
+	delete _thread;
+	delete [] _buffer;
+}
@@ -0,0 +1,255 @@
+// Blackjack Simulation : HandHistory
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.  See the included file 'COPYING'
+// for more information.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// This is a hand history: a record of every round played at a table -
+// the shoe position, the bets, every card dealt, every action and the
+// outcome of every hand - in a compact binary log.
+//
+// The table records each event as it happens, encoding it straight
+// into a ring buffer (a few bytes, and no locks: the table is the only
+// writer and the history's thread is the only reader.)  The thread
+// writes the buffer to the file in big chunks, so the table never
+// waits on the disk - unless it gets a whole buffer ahead, in which
+// case it waits for room rather than lose any history.
+//
+// The file starts with a header (see Header below, written in the byte
+// order of the machine), then each event is a byte: the high four bits
+// are the event and the low four bits are its argument.  An argument
+// of 15 (where noted) means the real value follows as a varint (seven
+// bits a byte, low bits first, high bit set on all but the last byte.)
+//
+//   0  Round       bit 0: the shoe was shuffled before this round
+//                  then varint: cards left in the shoe before the deal
+//   1  Hand        the following events are for hand <arg> (or 15
+//                  and a varint) of this round
+//   2  New hand    the following events are for a new hand, numbered
+//                  after the ones already in this round, of the player
+//                  in seat <arg> (or 15 and a varint)
+//   3  Dealer      the following events are for the dealer
+//   4  Card        a card is dealt, <arg> is its rank: 1 (ace) to 13
+//                  (king).  the dealer's first card is the hole card.
+//   5  Bet         then varint: the hand's bet
+//   6  Insurance   the hand took insurance
+//   7  Action      the hand's action, <arg> is a PlayAction (see
+//                  Strategy.h.)  a Split moves the hand's second card
+//                  to a new hand, then deals a card to each.
+//   8  Outcome     <arg> bits 0-1 are a HandOutcome (see Hand.h), bit
+//                  3 is set if the hand was a blackjack
+//
+// A resumed run (see Checkpoint.h) appends to its history, with a new
+// header giving the round it starts at.  (So rounds played after the
+// last checkpoint but before the run was stopped appear twice.)
+
+#ifndef HANDHISTORY_H
+#define HANDHISTORY_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include <stdint.h>
+#include <atomic>
+#include <thread>
+#include "Util.h"
+#include "Assert.h"
+#include "Card.h"
+#include "Hand.h"
+#include "Strategy.h"
+
+// empty declaration to avoid circular dependencies
+class Player;
+
+class HandHistory
+{
+	public:
+		static const char magic[8];
+		static const uint32_t version = 1;
+
+		// the file header
+		struct Header
+		{
+			char magic[8];			// HandHistory::magic
+			uint32_t version;		// HandHistory::version
+			uint32_t stream;		// the shoe's random stream (shard)
+			uint64_t seed;			// the shoe's seed
+			uint64_t firstRound;	// number of the first round logged
+		};
+
+		// the events, see above
+		enum Event { RoundEvent = 0, HandEvent = 1, NewHandEvent = 2,
+		 DealerEvent = 3, CardEvent = 4, BetEvent = 5,
+		 InsuranceEvent = 6, ActionEvent = 7, OutcomeEvent = 8 };
+
+		// start logging to the file at path (appending, if append is
+		// true) - throws std::runtime_error if it can't be opened
+		HandHistory(const char *path, uint64_t seed, uint32_t stream,
+		 uint64_t firstRound, bool append = false);
+
+		// start and end a round - the round's events are only handed
+		// to the writer once the round ends
+		void beginRound(uint16_t cardsLeft, bool shuffled);
+		void endRound();
+
+		// record an event for a player's hand (or the dealer's)
+		void bet(Player *player, Hand *hand, uint8_t bet);
+		void card(Player *player, Hand *hand, Card card);
+		void insurance(Player *player, Hand *hand);
+		void action(Player *player, Hand *hand, PlayAction action);
+		void outcome(Player *player, Hand *hand, HandOutcome outcome,
+		 bool blackjack);
+
+		void dealerCard(Card card);
+		void dealerAction(PlayAction action);
+
+		// writes everything logged so far and closes the file
+		~HandHistory();
+
+	private:
+		// size of the ring buffer (a power of two), and the most a
+		// single round can possibly add to it
+		static const size_t bufferSize = 1 << 20;
+		static const size_t maxRoundSize = 4096;
+
+		// most hands (and seats) we'll keep track of in a round
+		static const uint8_t maxHands = 64;
+
+		// ranks in a suit (Card::rankCount, as a constant)
+		static const uint8_t rankCount = 13;
+
+		// add a byte, an event or a varint to the round
+		void put(uint8_t byte);
+		void putEvent(Event event, uint32_t arg);
+		void putVarint(uint32_t value);
+
+		// make the following events for this hand (or the dealer),
+		// telling the reader about the hand if it's a new target
+		void target(Player *player, Hand *hand);
+		void retarget(Player *player, Hand *hand);
+
+		// the writer thread
+		static void run(HandHistory *history);
+
+		FILE *_fptr;					// the history file
+		uint8_t *_buffer;				// the ring buffer
+		size_t _tail;					// end of this round (table only)
+		size_t _headCache;				// last _head seen by the table
+		std::atomic<size_t> _head;		// first byte not yet written
+		std::atomic<size_t> _published;	// end of the last whole round
+		std::atomic<bool> _stop;		// the thread should exit
+		std::thread *_thread;			// the writer thread
+
+		// the hands (and their players) seen in this round, in the
+		// order they were first seen, and the current target
+		Hand *_hands[maxHands];
+		Player *_seats[maxHands];
+		uint8_t _handCount;
+		uint8_t _seatCount;
+		Hand *_target;
+		bool _targeted;
+};
+
+
+//
+// inline function definition
+//
+
+// put: add a byte to the round in the ring buffer
+inline void HandHistory::put(uint8_t byte)
+{
+	_buffer[_tail++ & (bufferSize - 1)] = byte;
+}
+
+// putVarint: add a varint to the round
+inline void HandHistory::putVarint(uint32_t value)
+{
+	while(value >= 0x80)
+	{
+		put((uint8_t)(value | 0x80));
+		value >>= 7;
+	}
+
+	put((uint8_t)value);
+}
+
+// putEvent: add an event (and its argument) to the round
+inline void HandHistory::putEvent(Event event, uint32_t arg)
+{
+	if(arg < 15)
+		put((uint8_t)((event << 4) | arg));
+	else
+	{
+		put((uint8_t)((event << 4) | 15));
+		putVarint(arg);
+	}
+}
+
+// target: make the following events for this hand (NULL for the
+//         dealer) - most events are for the same hand as the last
+inline void HandHistory::target(Player *player, Hand *hand)
+{
+	if(!_targeted || hand != _target)
+		retarget(player, hand);
+}
+
+// bet: a hand's bet
+inline void HandHistory::bet(Player *player, Hand *hand, uint8_t bet)
+{
+	target(player, hand);
+	putEvent(BetEvent, 0);
+	putVarint(bet);
+}
+
+// card: a card was dealt to a hand
+inline void HandHistory::card(Player *player, Hand *hand, Card card)
+{
+	target(player, hand);
+	putEvent(CardEvent, (card.getCode() % rankCount) + 1);
+}
+
+// insurance: a hand took insurance
+inline void HandHistory::insurance(Player *player, Hand *hand)
+{
+	target(player, hand);
+	putEvent(InsuranceEvent, 0);
+}
+
+// action: a hand's play - the cards it's dealt follow
+inline void HandHistory::action(Player *player, Hand *hand,
+ PlayAction action)
+{
+	target(player, hand);
+	putEvent(ActionEvent, action);
+}
+
+// outcome: how a hand ended
+inline void HandHistory::outcome(Player *player, Hand *hand,
+ HandOutcome outcome, bool blackjack)
+{
+	target(player, hand);
+	putEvent(OutcomeEvent, outcome | (blackjack ? 8 : 0));
+}
+
+// dealerCard: a card was dealt to the dealer
+inline void HandHistory::dealerCard(Card card)
+{
+	target(NULL, NULL);
+	putEvent(CardEvent, (card.getCode() % rankCount) + 1);
+}
+
+// dealerAction: the dealer's play
+inline void HandHistory::dealerAction(PlayAction action)
+{
+	target(NULL, NULL);
+	putEvent(ActionEvent, action);
+}
+
+#endif // HANDHISTORY_H
@@ -22,8 +22,10 @@
 // will return the data from the front of the list and set a "cursor".
 // Subsequent calls will increment the "cursor" and return the next
 // piece of data in the list.  When the end of the list is reached,
-// iterate() will return NULL.  Therefore, if one wishes to store
-// integer values which may be zero, it is advisable to use pointers.
+// iterate() will return a default-constructed T (NULL, for pointers.)
+// Therefore, if one wishes to store integer values which may be zero,
+// it is advisable to use pointers - or a class whose default value is
+// distinguishable, like Card.
 // You may remove the data which the cursor is currently pointing to
 // by using the remove() function.  If you wish to reset the cursor,
 // call the cursor() function.
@@ -31,6 +33,11 @@
 // NOTE: the LinkedList class does not do any memory management of your
 // objects.  When you remove an object, we do not call free() or delete().
 // Beware of memory leaks.
+//
+// The list's own nodes are kept when they're removed, and reused when
+// something is next added, so a list that is cleared and refilled over
+// and over (like a player's hands) stops allocating once it has reached
+// its largest size.  The nodes are freed when the list is destroyed.
 
 #ifndef LINKEDLIST_H
 #define LINKEDLIST_H
@@ -71,6 +78,10 @@ class LinkedList
 		LinkedListNode<T> *_last;		// last entry in list
 		LinkedListNode<T> *_itr_prev;	// previous in iteration loop
 		uint32_t _count;				// # items in list
+		LinkedListNode<T> *_spare;		// removed nodes, for reuse
+
+		LinkedListNode<T> *newNode(void);			// get a node
+		void freeNode(LinkedListNode<T> *entry);	// put a node back
 };
 
 
@@ -92,6 +103,36 @@ LinkedList<T>::LinkedList()
 
 	// we keep a count of the elements in the list -- clear it
 	_count = 0;
+
+	// there are no removed nodes to reuse yet
+	_spare = NULL;
+}
+
+
+// newNode : returns a node for a new entry - a node that was removed
+//           from the list earlier, if there is one
+template <class T>
+LinkedListNode<T> *LinkedList<T>::newNode(void)
+{
+	LinkedListNode<T> *entry;
+
+	if(_spare == NULL)
+		return new LinkedListNode<T>;
+
+	entry = _spare;
+	_spare = entry->next;
+
+	return entry;
+}
+
+
+// freeNode : keeps a node that was removed from the list for reuse.
+//            the spare nodes are linked through their next pointers.
+template <class T>
+void LinkedList<T>::freeNode(LinkedListNode<T> *entry)
+{
+	entry->next = _spare;
+	_spare = entry;
 }
 
 
@@ -108,7 +149,7 @@ T LinkedList<T>::iterate(void)
 	if(_itr_prev != NULL && _itr_prev->next == NULL)
 	{
 		_itr_prev = NULL;
-		return NULL;
+		return T();
 	}
 
 	// there's no list to iterate over -- ie, _first is NULL when the
@@ -117,7 +158,7 @@ T LinkedList<T>::iterate(void)
 	else if(_itr_prev == NULL && _first == NULL)
 	{
 		_itr_prev = NULL;
-		return NULL;
+		return T();
 	}
 
 	// this is the first time iterate has been called - there's no
@@ -160,7 +201,7 @@ bool LinkedList<T>::addFront(T data)
 {
 	LinkedListNode<T> *entry;
 
-	entry = new LinkedListNode<T>();
+	entry = newNode();
 
 	// since this is going at the head of the list, this node will have
 	// no previous entry, and this node's next entry will be what was
@@ -193,7 +234,7 @@ bool LinkedList<T>::addTail(T data)
 {
 	LinkedListNode<T> *entry;
 
-	entry = new LinkedListNode<T>;
+	entry = newNode();
 
 	// since this is going at the tail of the list, this node will have
 	// no next entry, and this node's previous entry will be what was
@@ -235,7 +276,7 @@ T LinkedList<T>::remove(void)
 
 	// iterate() has not yet been called
 	if(_itr_prev == NULL)
-		return NULL;
+		return T();
 
 	// get the previously returned entry to iterate() and get the data
 	// so we can return it after the entry is removed.
@@ -262,9 +303,13 @@ T LinkedList<T>::remove(void)
 	else
 		entry->next->previous = entry->previous;
 
-	// free the memory taken up by the node.  note that we don't free
-	// the data that was passed to us by the caller.
-	delete entry;
+	// back the cursor up, so that the next call to iterate() returns
+	// the entry after this one (or the first entry, if this was it)
+	_itr_prev = entry->previous;
+
+	// keep the node for reuse.  note that we don't free the data that
+	// was passed to us by the caller.
+	freeNode(entry);
 
 	// decrement the count
 	_count--;
@@ -286,7 +331,7 @@ T LinkedList<T>::removeFront(void)
 	// if there's no first element (ie, the list is empty) there's nothing
 	// to remove.
 	if(_first == NULL)
-		return NULL;
+		return T();
 
 	// get the head node and get the data so we can return it after the
 	// head node is removed.
@@ -303,9 +348,9 @@ T LinkedList<T>::removeFront(void)
 	else
 		_first->previous = NULL;
 
-	// free the memory taken up by the node.  note that we don't free
-	// the data that was passed to us by the caller.
-	delete entry;
+	// keep the node for reuse.  note that we don't free the data that
+	// was passed to us by the caller.
+	freeNode(entry);
 
 	// decrement the count
 	_count--;
@@ -327,7 +372,7 @@ T LinkedList<T>::removeTail(void)
 	// if there's no tail element (ie, the list is empty) there's nothing
 	// to remove.
 	if(_last == NULL)
-		return NULL;
+		return T();
 
 	// get the tail node and get the data so we can return it after the
 	// tail node is removed.
@@ -345,9 +390,9 @@ T LinkedList<T>::removeTail(void)
 	else
 		_last->next = NULL;
 
-	// free the memory taken up by the node.  note that we don't free
-	// the data that was passed to us by the caller.
-	delete entry;
+	// keep the node for reuse.  note that we don't free the data that
+	// was passed to us by the caller.
+	freeNode(entry);
 
 	// decrement the count
 	_count--;
@@ -367,7 +412,7 @@ T LinkedList<T>::fetchFront(void)
 	// if there's no front element (ie, the list is empty) there's nothing
 	// to fetch
 	if(_first == NULL)
-		return NULL;
+		return T();
 
 	// get the tail node and return the data
 	entry = _first;
@@ -387,7 +432,7 @@ T LinkedList<T>::fetchTail(void)
 	// if there's no tail element (ie, the list is empty) there's nothing
 	// to fetch
 	if(_last == NULL)
-		return NULL;
+		return T();
 
 	// get the tail node and return the data
 	entry = _last;
@@ -410,7 +455,7 @@ T LinkedList<T>::fetchNumber(uint16_t idx)
 			return entry->data;
 	}
 
-	return NULL;
+	return T();
 }
 
 
@@ -448,12 +493,12 @@ void LinkedList<T>::clear(void)
 {
 	LinkedListNode<T> *entry, *next;
 
-	// walk the linked list and destroy nodes
+	// walk the linked list and keep the nodes for reuse
 	for(entry = _first; entry != NULL; entry = next)
 	{
 		next = entry->next;
 
-		delete entry;
+		freeNode(entry);
 	}
 
 	// the linked list starts out empty - clear the head and tail node
@@ -482,6 +527,14 @@ LinkedList<T>::~LinkedList()
 
 		delete entry;
 	}
+
+	// and the spare nodes
+	for(entry = _spare; entry != NULL; entry = next)
+	{
+		next = entry->next;
+
+		delete entry;
+	}
 }
 
 #endif // LINKEDLIST_H
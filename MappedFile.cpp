@@ -0,0 +1,176 @@
+// Blackjack Simulation : MappedFile
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.  See the included file 'COPYING'
+// for more information.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// This is a read-only file mapped into memory, and atomic file writes.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <exception>
+#include <stdexcept>
+#include "Util.h"
+#include "Assert.h"
+#include "MappedFile.h"
+
+#ifdef WIN32
+# include <io.h>
+# define fsync_portable(fd)	_commit(fd)
+#else // WIN32
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <fcntl.h>
+# define fsync_portable(fd)	fsync(fd)
+#endif // WIN32
+
+MappedFile::MappedFile(const char *path)
+{
+	ASSERT(path != NULL);
+
+	_data = NULL;
+	_size = 0;
+
+#ifdef WIN32
+	LARGE_INTEGER size;
+
+	_file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+	 OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+	if(_file == INVALID_HANDLE_VALUE)
+		throw std::runtime_error("could not open file");
+
+	if(!GetFileSizeEx(_file, &size))
+	{
+		CloseHandle(_file);
+		throw std::runtime_error("could not read file");
+	}
+
+	_size = (size_t)size.QuadPart;
+	_mapping = NULL;
+
+	// an empty file can't be mapped, but it has nothing to map
+	if(_size == 0)
+		return;
+
+	if((_mapping = CreateFileMapping(_file, NULL, PAGE_READONLY,
+	 0, 0, NULL)) == NULL ||
+	 (_data = MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0)) == NULL)
+	{
+		if(_mapping != NULL)
+			CloseHandle(_mapping);
+
+		CloseHandle(_file);
+		throw std::runtime_error("could not map file");
+	}
+#else // WIN32
+	struct stat st;
+	int fd;
+
+	if((fd = open(path, O_RDONLY)) < 0)
+		throw std::runtime_error("could not open file");
+
+	if(fstat(fd, &st) < 0 || !S_ISREG(st.st_mode))
+	{
+		close(fd);
+		throw std::runtime_error("could not read file");
+	}
+
+	_size = (size_t)st.st_size;
+
+	// an empty file can't be mapped, but it has nothing to map
+	if(_size > 0)
+	{
+		void *data = mmap(NULL, _size, PROT_READ, MAP_SHARED, fd, 0);
+
+		if(data == MAP_FAILED)
+		{
+			close(fd);
+			throw std::runtime_error("could not map file");
+		}
+
+		_data = data;
+	}
+
+	// the mapping doesn't need the file to stay open
+	close(fd);
+#endif // WIN32
+}
+
+// getData: returns the contents of the file (NULL if it's empty)
+const void *MappedFile::getData()
+{
+	return _data;
+}
+
+// getSize: returns the size of the file in bytes
+size_t MappedFile::getSize()
+{
+	return _size;
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef WIN32
+	if(_data != NULL)
+		UnmapViewOfFile(_data);
+
+	if(_mapping != NULL)
+		CloseHandle(_mapping);
+
+	CloseHandle(_file);
+#else // WIN32
+	if(_data != NULL)
+		munmap((void *)_data, _size);
+#endif // WIN32
+}
+
+// WriteFileAtomic: write the data to a temporary file, make sure it's on
+//                  the disk and then rename it into place, so that the
+//                  file at path is always either the old file or the
+//                  whole new one
+bool WriteFileAtomic(const char *path, const void *data, size_t size)
+{
+	size_t len = strlen(path) + 5;
+	char *tmpPath = new char[len];
+	FILE *fptr;
+	bool written;
+
+	snprintf(tmpPath, len, "%s.tmp", path);
+
+	if((fptr = fopen(tmpPath, "wb")) == NULL)
+	{
+		delete [] tmpPath;
+		return false;
+	}
+
+	written = (fwrite(data, 1, size, fptr) == size &&
+	 fflush(fptr) == 0 && fsync_portable(fileno(fptr)) == 0);
+
+	if(fclose(fptr) != 0)
+		written = false;
+
+#ifdef WIN32
+	if(written)
+		written = (MoveFileExA(tmpPath, path, MOVEFILE_REPLACE_EXISTING) != 0);
+#else // WIN32
+	if(written)
+		written = (rename(tmpPath, path) == 0);
+#endif // WIN32
+
+	if(!written)
+		remove(tmpPath);
+
+	delete [] tmpPath;
+
+	return written;
+}
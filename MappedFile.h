@@ -0,0 +1,59 @@
+// Blackjack Simulation : MappedFile
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.  See the included file 'COPYING'
+// for more information.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// This is a read-only file mapped into memory, so that binary files
+// (like statistics snapshots) can be used in place without reading or
+// parsing them.  The mapping lasts as long as the object does.
+//
+// WriteFileAtomic() goes with it: it writes a whole file under a
+// temporary name, makes sure it's on the disk and renames it into
+// place, so that a reader (or a reboot) only ever sees the old file or
+// all of the new one.
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <stdlib.h>
+#include <sys/types.h>
+#include <stdint.h>
+#include "Util.h"
+#include "Assert.h"
+
+class MappedFile
+{
+	public:
+		// map the file at path - throws std::runtime_error if it
+		// can't be opened or mapped
+		MappedFile(const char *path);
+
+		// the file's contents, and its size in bytes
+		const void *getData();
+		size_t getSize();
+
+		~MappedFile();
+
+	private:
+		const void *_data;
+		size_t _size;
+
+#ifdef WIN32
+		HANDLE _file;
+		HANDLE _mapping;
+#endif
+};
+
+// write size bytes of data to the file at path, atomically - returns
+// false if it couldn't be written (and the old file is left alone)
+bool WriteFileAtomic(const char *path, const void *data, size_t size);
+
+#endif // MAPPEDFILE_H
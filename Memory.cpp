@@ -0,0 +1,85 @@
+// Blackjack Simulation : Memory
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.  See the included file 'COPYING'
+// for more information.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// Allocation counting - see Memory.h.  The count is kept per thread so
+// that each shard of a simulation only sees its own allocations, and so
+// that counting doesn't need any locking.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <new>
+#include "Util.h"
+#include "Assert.h"
+#include "Memory.h"
+
+#ifdef DEBUG
+
+static thread_local uint64_t allocationCount = 0;
+
+// AllocationCount: returns the number of allocations made by the calling
+//                  thread so far
+uint64_t AllocationCount()
+{
+	return allocationCount;
+}
+
+// operator new: count the allocation and hand it off to malloc
+void *operator new(size_t size)
+{
+	void *ptr;
+
+	allocationCount++;
+
+	if((ptr = malloc(size ? size : 1)) == NULL)
+		throw std::bad_alloc();
+
+	return ptr;
+}
+
+// operator new[]: arrays are counted just like single objects
+void *operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+// operator delete: give the memory back to free
+void operator delete(void *ptr) noexcept
+{
+	free(ptr);
+}
+
+// operator delete[]: give the memory back to free
+void operator delete[](void *ptr) noexcept
+{
+	free(ptr);
+}
+
+// operator delete (sized): give the memory back to free
+void operator delete(void *ptr, size_t size) noexcept
+{
+	// suppress unused warnings
+	size = size;
+
+	free(ptr);
+}
+
+// operator delete[] (sized): give the memory back to free
+void operator delete[](void *ptr, size_t size) noexcept
+{
+	// suppress unused warnings
+	size = size;
+
+	free(ptr);
+}
+
+#endif // DEBUG
@@ -0,0 +1,34 @@
+// Blackjack Simulation : Memory
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.  See the included file 'COPYING'
+// for more information.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// Allocation counting - when compiled with -DDEBUG, the global new and
+// delete operators are replaced with ones that count the allocations
+// made by each thread.  The table uses this to check how many times a
+// round of play allocates memory (see Table::report), which should be
+// never, once the table is up and running.
+//
+// (In release mode, there's no counting and no replacement operators.)
+
+#ifndef MEMORY_H
+#define MEMORY_H
+
+#include <stdint.h>
+
+#ifdef DEBUG
+
+// number of allocations made by the calling thread so far
+uint64_t AllocationCount();
+
+#endif // DEBUG
+
+#endif // MEMORY_H
@@ -26,6 +26,7 @@
 #include "StrategyLookup.h"
 #include "Hand.h"
 #include "Statistics.h"
+#include "Checkpoint.h"
 
 
 Player::Player(const char *strategyName)
@@ -44,13 +45,16 @@ Player::Player(const char *strategyName)
 		throw;
 	}
 
-	// setup a linked list for the hands for this player
+	// setup a linked list for the hands for this player, and one for
+	// the hands that are waiting to be reused
 	try {
 		_hands = new LinkedList<Hand *>();
+		_handPool = new LinkedList<Hand *>();
 	}
 	catch(...) {
 		// need to delete the strategy instantiated above to avoid memleaks
 		delete _strategy;
+		delete _hands;
 
 		// rethrow exception
 		throw;
@@ -64,29 +68,41 @@ Player::Player(const char *strategyName)
 		// cleanup to avoid memleaks
 		delete _strategy;
 		delete _hands;
+		delete _handPool;
 
 		// rethrow exception
 		throw;	
 	}
 }
 
-// clearHands: delete the current hands for this player and create a
-//             new one
+// clearHands: put the current hands for this player back in the pool
+//             and give them a new (empty) one
 void Player::clearHands()
 {
 	Hand *hand;
 
 	_handsPlayed++;
 
-	// delete each hand in play
+	// keep each hand in play for reuse
 	while((hand = _hands->removeTail()) != NULL)
-		delete hand;
+		_handPool->addTail(hand);
+
+	// get a new hand, add it to the list of hands
+	_hands->add(newHand());
+}
 
-	// create a new hand
-	hand = new Hand();
+// newHand: returns an empty hand - from the pool of hands used in earlier
+//          rounds if there is one, otherwise a new hand.  once a player
+//          has played their largest split, there's always one waiting.
+Hand *Player::newHand(bool isSplit)
+{
+	Hand *hand;
 
-	// add it to the list of hands
-	_hands->add(hand);
+	if((hand = _handPool->removeTail()) == NULL)
+		return new Hand(isSplit);
+
+	hand->reset(isSplit);
+	return hand;
 }
 
 // getHands: hands accessor function
@@ -117,7 +133,7 @@ Strategy *Player::getStrategy()
 }
 
 // handsPlayed: returns the number of hands played
-uint32_t Player::handsPlayed()
+uint64_t Player::handsPlayed()
 {
 	return _handsPlayed;
 }
@@ -135,7 +151,7 @@ void Player::addBuyin(uint16_t bank)
 //              we do not use a float for bankroll to avoid floating
 //              point rounding errors.  it's difficult to bet
 //              9.99999999 dollars, after all
-void Player::addBankroll(uint16_t bank, uint16_t bankChange)
+void Player::addBankroll(uint32_t bank, uint16_t bankChange)
 {
 	ASSERT(bankChange < 100);
 
@@ -170,7 +186,7 @@ void Player::removeBankroll(uint16_t bank, uint16_t bankChange)
 }
 
 // getBankroll: return the current bankroll
-uint16_t Player::getBankroll()
+uint32_t Player::getBankroll()
 {
 	return _bankroll;
 }
@@ -182,21 +198,63 @@ uint8_t Player::getBankrollChange()
 }
 
 // getBuyin: return the total buyin so far
-uint32_t Player::getBuyin()
+uint64_t Player::getBuyin()
 {
 	return _buyinTotal;
 }
 
+// merge: add another player's totals into this player.  the players
+//        should be playing the same strategy, or the statistics won't
+//        mean much.
+void Player::merge(Player *other)
+{
+	_handsPlayed += other->_handsPlayed;
+	_buyinTotal += other->_buyinTotal;
+
+	addBankroll(other->_bankroll, other->_bankrollChange);
+
+	_statistics->merge(*other->_statistics);
+}
+
+// save: save the player's totals, statistics and strategy state
+void Player::save(Checkpoint *checkpoint)
+{
+	checkpoint->put(_handsPlayed);
+	checkpoint->put(_buyinTotal);
+	checkpoint->put(_bankroll);
+	checkpoint->put(_bankrollChange);
+
+	_statistics->save(checkpoint);
+	_strategy->saveState(checkpoint);
+}
+
+// restore: restore the player's totals, statistics and strategy state
+//          from a checkpoint
+void Player::restore(Checkpoint *checkpoint)
+{
+	checkpoint->get(_handsPlayed);
+	checkpoint->get(_buyinTotal);
+	checkpoint->get(_bankroll);
+	checkpoint->get(_bankrollChange);
+
+	_statistics->restore(checkpoint);
+	_strategy->loadState(checkpoint);
+}
+
 Player::~Player()
 {
 	Hand *hand;
 
-	// delete each hand
+	// delete each hand, and each hand waiting to be reused
 	while((hand = _hands->removeTail()) != NULL)
 		delete hand;
 
+	while((hand = _handPool->removeTail()) != NULL)
+		delete hand;
+
 	delete _strategy;
 	delete _hands;
+	delete _handPool;
 	delete _statistics;
 }
 
@@ -26,6 +26,9 @@
 #include "Hand.h"
 #include "Statistics.h"
 
+// empty declaration to avoid including the threading headers
+class Checkpoint;
+
 
 class Player
 {
@@ -38,6 +41,10 @@ class Player
 		// hand accessor
 		LinkedList<Hand *> *getHands(void);
 
+		// get an empty hand, reusing one from an earlier round if we
+		// can - add it to the player's hands with addHand()
+		Hand *newHand(bool isSplit = false);
+
 		// give the player another hand - typically used in a split
 		void addHand(Hand *hand);
 
@@ -48,14 +55,14 @@ class Player
 		Statistics *getStatistics();
 
 		// return the number of hands played
-		uint32_t handsPlayed();
+		uint64_t handsPlayed();
 
 		// buyin - we keep track of how much money is put in and then
 		// put it into the bankroll
 		void addBuyin(uint16_t bank);
 
 		// add bankroll - suitable for pays to the player
-		void addBankroll(uint16_t bank, uint16_t bankChange = 0);
+		void addBankroll(uint32_t bank, uint16_t bankChange = 0);
 
 		// remove from bankroll - when a hand is played
 		void removeBankroll(uint16_t bank, uint16_t bankChange = 0);
@@ -65,21 +72,31 @@ class Player
 		// floating point rounding, but we do need to keep track of
 		// change for 3:2 blackjack payouts on odd bets (eg, 3:2 on
 		// a $5 bet is a $7.50 payout)
-		uint16_t getBankroll();
+		uint32_t getBankroll();
 		uint8_t getBankrollChange();
 
 		// get the total buyin so far
-		uint32_t getBuyin();
+		uint64_t getBuyin();
+
+		// add another player's hands, buyins, bankroll and statistics
+		// into this one (used to combine the shards of a parallel run)
+		void merge(Player *other);
+
+		// save or restore the player's totals, statistics and strategy
+		// (see Checkpoint.h)
+		void save(Checkpoint *checkpoint);
+		void restore(Checkpoint *checkpoint);
 
 		~Player();
 
 	private:
-		uint32_t _handsPlayed;			// number of hands played
-		uint32_t _buyinTotal;			// total amount bought in at
-		uint16_t _bankroll;				// current bankroll
+		uint64_t _handsPlayed;			// number of hands played
+		uint64_t _buyinTotal;			// total amount bought in at
+		uint32_t _bankroll;				// current bankroll
 		uint8_t _bankrollChange;		// bankroll change (in pennies)
 		Strategy *_strategy;			// playing strategy (see Strategy.h)
 		LinkedList<Hand *> *_hands;		// list of hands currently played
+		LinkedList<Hand *> *_handPool;	// hands from earlier rounds
 		Statistics *_statistics;		// statistics for this strategy
 };
 
@@ -0,0 +1,95 @@
+// Blackjack Simulation : Utility Library : Random
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.  See the included file 'COPYING'
+// for more information.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// A seedable pseudo-random number generator - xoshiro256** by David
+// Blackman and Sebastiano Vigna (http://prng.di.unimi.it).  See
+// Random.h for the details.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include "Util.h"
+#include "Assert.h"
+#include "Random.h"
+#include "Checkpoint.h"
+
+Random::Random(uint64_t seed, uint32_t stream)
+{
+	this->seed(seed, stream);
+}
+
+// seed: fill the generator state from a single 64 bit seed, then jump
+//       ahead to the requested stream.  the state is filled with
+//       splitmix64, as recommended by the xoshiro authors, so that
+//       similar seeds (eg, 1 and 2) still give unrelated sequences and
+//       the state is never all zeroes.
+void Random::seed(uint64_t seed, uint32_t stream)
+{
+	for(int i = 0; i < 4; i++)
+	{
+		uint64_t z = (seed += 0x9e3779b97f4a7c15ULL);
+
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+
+		_state[i] = z ^ (z >> 31);
+	}
+
+	for(uint32_t i = 0; i < stream; i++)
+		jump();
+}
+
+// jump: advance the generator by 2^128 calls to next().  this is used to
+//       give each stream its own non-overlapping piece of the sequence.
+void Random::jump(void)
+{
+	static const uint64_t jumpPoly[] = {
+		0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+		0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+	};
+
+	uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+
+	for(int i = 0; i < 4; i++)
+	{
+		for(int b = 0; b < 64; b++)
+		{
+			if(jumpPoly[i] & ((uint64_t)1 << b))
+			{
+				s0 ^= _state[0];
+				s1 ^= _state[1];
+				s2 ^= _state[2];
+				s3 ^= _state[3];
+			}
+
+			next();
+		}
+	}
+
+	_state[0] = s0;
+	_state[1] = s1;
+	_state[2] = s2;
+	_state[3] = s3;
+}
+
+// save: save the generator state, so that it can carry on from here
+void Random::save(Checkpoint *checkpoint)
+{
+	checkpoint->put(_state);
+}
+
+// restore: restore the generator state from a checkpoint
+void Random::restore(Checkpoint *checkpoint)
+{
+	checkpoint->get(_state);
+}
@@ -0,0 +1,143 @@
+// Blackjack Simulation : Utility Library : Random
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.  See the included file 'COPYING'
+// for more information.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// A seedable pseudo-random number generator - xoshiro256** by David
+// Blackman and Sebastiano Vigna (http://prng.di.unimi.it).  Unlike
+// rand(3), each generator keeps its own state, so every shoe can have
+// its own generator and a given seed always produces the same cards on
+// any platform.
+//
+// A generator is created from a seed and a "stream" number.  Streams
+// are 2^128 numbers apart in the generator's sequence (see jump()), so
+// streams created from the same seed never overlap - shard N of a
+// parallel run simply uses stream N.
+//
+// next() is defined in this header so that it can be inlined into the
+// shuffle loop.
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdlib.h>
+#include <sys/types.h>
+#include <stdint.h>
+#include "Util.h"
+#include "Assert.h"
+
+// empty declaration to avoid including the threading headers
+class Checkpoint;
+
+//
+// class declaration
+//
+
+class Random
+{
+	public:
+		Random(uint64_t seed = 0, uint32_t stream = 0);
+
+		// reseed the generator, and skip ahead to the given stream
+		void seed(uint64_t seed, uint32_t stream = 0);
+
+		// returns the next 64 random bits
+		uint64_t next(void);
+
+		// returns a random number in [0, 1)
+		double nextDouble(void);
+
+		// returns a random number in [0, range) without modulo bias
+		uint32_t bounded(uint32_t range);
+
+		// skip ahead 2^128 numbers in the sequence
+		void jump(void);
+
+		// save or restore the generator state (see Checkpoint.h)
+		void save(Checkpoint *checkpoint);
+		void restore(Checkpoint *checkpoint);
+
+	private:
+		static uint64_t rotl(const uint64_t x, int k);
+
+		uint64_t _state[4];				// generator state
+};
+
+
+//
+// inline function definition
+//
+
+// rotl : rotate left
+inline uint64_t Random::rotl(const uint64_t x, int k)
+{
+	return (x << k) | (x >> (64 - k));
+}
+
+
+// next : returns the next 64 bits from the generator and advances the
+//        state
+inline uint64_t Random::next(void)
+{
+	const uint64_t result = rotl(_state[1] * 5, 7) * 9;
+	const uint64_t t = _state[1] << 17;
+
+	_state[2] ^= _state[0];
+	_state[3] ^= _state[1];
+	_state[1] ^= _state[2];
+	_state[0] ^= _state[3];
+
+	_state[2] ^= t;
+
+	_state[3] = rotl(_state[3], 45);
+
+	return result;
+}
+
+
+// nextDouble : returns a random number in [0, 1) - the top 53 bits
+//              fill the mantissa of a double exactly
+inline double Random::nextDouble(void)
+{
+	return (double)(next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+
+// bounded : returns a uniformly distributed number in [0, range).  this
+//           is Daniel Lemire's "nearly divisionless" method: multiply 32
+//           random bits by the range and keep the high word.  a few low
+//           words would make some results slightly more likely than
+//           others (the same bias as rand() % range) so those draws are
+//           rejected, but that only costs a division (and rarely a
+//           redraw) when the low word lands in the biased region.
+inline uint32_t Random::bounded(uint32_t range)
+{
+	uint64_t product = (next() >> 32) * (uint64_t)range;
+	uint32_t low = (uint32_t)product;
+
+	ASSERT(range > 0);
+
+	if(low < range)
+	{
+		// 2^32 mod range: the number of low words that are biased
+		uint32_t threshold = (0 - range) % range;
+
+		while(low < threshold)
+		{
+			product = (next() >> 32) * (uint64_t)range;
+			low = (uint32_t)product;
+		}
+	}
+
+	return (uint32_t)(product >> 32);
+}
+
+#endif // RANDOM_H
@@ -20,6 +20,12 @@
 // We simulate the "stopper" card by picking a random number between
 // 104-156 (ie, 2 to 3 decks from the end) and stopping when there
 // are that many cards left in the draw pile.
+//
+// A "lazy" shoe doesn't shuffle up front - instead, each deal() does
+// one step of the shuffle, picking the card at random from the cards
+// not yet dealt.  The cards come out in exactly the same distribution
+// (and, for the same random numbers, in the same order) as a full
+// shuffle, but the cards behind the stopper never cost anything.
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -30,9 +36,11 @@
 #include "Util.h"
 #include "Assert.h"
 #include "Card.h"
+#include "Random.h"
 #include "Shoe.h"
+#include "Checkpoint.h"
 
-Shoe::Shoe(uint8_t numdecks)
+Shoe::Shoe(uint8_t numdecks, uint64_t seed, uint32_t stream)
 {
 	// setup some defaults
 	_cards = NULL;
@@ -42,13 +50,17 @@ Shoe::Shoe(uint8_t numdecks)
 	_numcards = _numdecks * Card::rankCount * Card::suitCount;
 	_numdealt = 0;
 	_stopper = 0;
+	_lazy = false;
 
-	// seed the pseudo-random number generator with the current time
-	// and the PID
-	srand_portable();
+	// seed our own pseudo-random number generator - the shoe doesn't
+	// share generator state with anybody, so that every table may run
+	// on its own thread, and a given seed and stream always deal the
+	// same cards
+	_random.seed(seed, stream);
 
-	// malloc an array for the cards
-	_cards = new Card*[_numcards];
+	// malloc an array for the cards - cards are a single byte, so the
+	// whole shoe is a few cache lines
+	_cards = new Card[_numcards];
 
 	// put the cards into the shoe -- each deck gets one rank of each suit
 	int cardcnt = 0;
@@ -66,9 +78,7 @@ Shoe::Shoe(uint8_t numdecks)
 			for(uint8_t k = 0; k < Card::rankCount; k++)
 			{
 				// and create that card
-				Card *card = new Card(Card::suitList[j], Card::rankList[k]);
-
-				_cards[cardcnt++] = card;
+				_cards[cardcnt++] = Card(Card::suitList[j], Card::rankList[k]);
 			}
 		}
 	}
@@ -76,64 +86,50 @@ Shoe::Shoe(uint8_t numdecks)
 	shuffle();
 }
 
-// shuffle : shuffle the deck using the method outlined by most online
-//           casinos, that is for each card in the deck, assign a random
-//           number ("weight") to the card.  then sort by the weight.
+// shuffle : shuffle the deck with a Fisher-Yates (Knuth) shuffle: walk
+//           the shoe from the top, swapping each card with a randomly
+//           chosen card at or below it.  every ordering of the shoe is
+//           equally likely (as long as the random numbers are unbiased,
+//           see Random::bounded()) and it takes one random number per
+//           card.
 void Shoe::shuffle()
 {
 	// determine the number of cards per deck
 	int cardsPerDeck = Card::rankCount * Card::suitCount;
 
-	// assign a (pseudo-)random weight to each card in the shoe
-	for(uint16_t i = 0; i < _numcards; i++)
+	// setup the stopper - we want a random number between 52 and 156
+	// (ie, 2 decks +/- 1 deck.)
+	_stopper = cardsPerDeck + _random.bounded(cardsPerDeck * 2);
+
+	// a lazy shoe does each step of the shuffle as the card is dealt,
+	// so we just go back to the top and burn a card
+	if(_lazy)
 	{
-		// set the weight
-		_cards[i]->setWeight(rand());
+		_draw = _cards;
+		_numdealt = 0;
+
+		deal();
+		return;
 	}
 
-	// sort the cards by weight using qsort(3)
-	qsort(_cards, _numcards, sizeof(Card *), ShoeShuffleCompare);
+	for(uint16_t i = 0; i < _numcards - 1; i++)
+	{
+		// pick one of the cards that haven't been placed yet
+		uint16_t j = i + (uint16_t)_random.bounded(_numcards - i);
+
+		Card card = _cards[i];
+		_cards[i] = _cards[j];
+		_cards[j] = card;
+	}
 
 	// set the deal point at the beginning of the card list
 	_draw = _cards;
 
-	// setup the stopper - note that some (old, poor) implementations of
-	// rand(3) have the less random bits in the lower-order bits.  see
-	// linux rand(3) or "Numerical Recipes in C": Flannery, et. al.
-	// we want a random number between 52 and 104 (ie, 2.5 decks +/-
-	// .5 deck.)
-	_stopper = cardsPerDeck +
-	 (int)((cardsPerDeck * 2) * (double)(rand() / (RAND_MAX + 1.0)));
-
 	// a single card gets "burned" at the beginning of the deal
 	_draw++;
 	_numdealt = 1;
 }
 
-// ShoeShuffleCompare : comparison function for qsort(3).  compares the
-//                      weight of two cards in a manner suitable for
-//                      qsort(3).
-int ShoeShuffleCompare(const void *ptr1, const void *ptr2)
-{
-	// whee, casting void pointers - but realistically, quite safe when
-	// qsort(3) is calling us
-	Card *card1 = *(Card **)ptr1;
-	Card *card2 = *(Card **)ptr2;
-
-	// get the weight of each card
-	int weight1 = card1->getWeight();
-	int weight2 = card2->getWeight();
-
-	// qsort expects -1 if input1 < input2, 1 if input1 > input2,
-	// 0 if input1 == input2
-	if(weight1 < weight2)
-		return -1;
-	else if(weight1 == weight2)
-		return 0;
-	else
-		return 1;
-}
-
 // stopperReached: returns true if we've reached the virtual "little
 //                 yellow card" that tells us to stop dealing.
 bool Shoe::stopperReached()
@@ -146,34 +142,84 @@ bool Shoe::stopperReached()
 
 // deal: return a single card from the top of the deck and increment
 //       the draw pointer
-Card *Shoe::deal()
+Card Shoe::deal()
 {
 	ASSERT(_numdealt < _numcards);
 
+	// a lazy shoe does one step of the shuffle now - pick any of the
+	// cards that haven't been dealt yet and swap it to the top
+	if(_lazy)
+	{
+		uint16_t j = _numdealt + (uint16_t)_random.bounded(_numcards - _numdealt);
+
+		Card swap = _cards[_numdealt];
+		_cards[_numdealt] = _cards[j];
+		_cards[j] = swap;
+	}
+
 	// whee pointer arithmetic - post-increment the draw pointer after
 	// dereferencing it.  ie, get the card at the draw pointer and set
 	// it to the next card.
-	Card *card = *(_draw++);
+	Card card = *(_draw++);
 
 	_numdealt++;
 
 	return card;
 }
 
+// setLazy: shuffle each card as it is dealt (see deal()) instead of the
+//          whole shoe at once.  takes effect at the next shuffle.
+void Shoe::setLazy(bool lazy)
+{
+	_lazy = lazy;
+}
+
 // cardsLeft: returns number of cards left in the shoe
 uint16_t Shoe::cardsLeft()
 {
 	return(_numcards - _numdealt);
 }
 
-Shoe::~Shoe()
+// save: save the order of the cards, how far we've dealt and the random
+//       number generator
+void Shoe::save(Checkpoint *checkpoint)
 {
-	// delete each card
-	for(uint16_t i = 0; i < _numcards; i++)
-	{
-		delete _cards[i];
-	}
+	checkpoint->put(_numcards);
+	checkpoint->write(_cards, _numcards * sizeof(Card));
+	checkpoint->put(_numdealt);
+	checkpoint->put(_stopper);
+	checkpoint->put(_lazy);
+
+	_random.save(checkpoint);
+}
+
+// restore: restore the shoe from a checkpoint - it must hold the same
+//          number of cards as the shoe that was saved
+void Shoe::restore(Checkpoint *checkpoint)
+{
+	uint16_t numcards;
+
+	checkpoint->get(numcards);
 
-	// and delete the card array
-	delete _cards;
+	if(numcards != _numcards)
+		throw std::runtime_error("checkpoint has a different shoe");
+
+	checkpoint->read(_cards, _numcards * sizeof(Card));
+	checkpoint->get(_numdealt);
+	checkpoint->get(_stopper);
+	checkpoint->get(_lazy);
+
+	if(_numdealt > _numcards)
+		throw std::runtime_error("checkpoint has a bad shoe");
+
+	// the cards before the draw pointer have all been dealt
+	_draw = _cards + _numdealt;
+
+	_random.restore(checkpoint);
+}
+
+Shoe::~Shoe()
+{
+	// delete the card array
+	delete [] _cards;
 }
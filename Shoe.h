@@ -20,6 +20,12 @@
 // We simulate the "stopper" card by picking a random number between
 // 104-156 (ie, 2 to 3 decks from the end) and stopping when there
 // are that many cards left in the draw pile.
+//
+// A "lazy" shoe doesn't shuffle up front - instead, each deal() does
+// one step of the shuffle, picking the card at random from the cards
+// not yet dealt.  The cards come out in exactly the same distribution
+// (and, for the same random numbers, in the same order) as a full
+// shuffle, but the cards behind the stopper never cost anything.
 
 #ifndef SHOE_H
 #define SHOE_H
@@ -29,39 +35,52 @@
 #include "Util.h"
 #include "Assert.h"
 #include "Card.h"
+#include "Random.h"
+
+// empty declaration to avoid including the threading headers
+class Checkpoint;
 
 class Shoe
 {
 	public:
-		Shoe(uint8_t numdecks = 6);
+		// the seed and stream pick the shoe's random number sequence,
+		// see Random.h
+		Shoe(uint8_t numdecks, uint64_t seed, uint32_t stream = 0);
 
 		// shuffle the shoe
 		void shuffle();
 
+		// shuffle each card as it is dealt rather than the whole shoe
+		// at once (takes effect on the next shuffle)
+		void setLazy(bool lazy = true);
+
 		// if the "stopper" card has been reached, it's time to shuffle
 		// the shoe
 		bool stopperReached();
 
 		// pull a single card out of the top of the deck and return it
-		Card *deal();
+		Card deal();
 
 		// number of cards left in the shoe
 		uint16_t cardsLeft();
 
+		// save or restore the cards, the deal position and the random
+		// number generator (see Checkpoint.h)
+		void save(Checkpoint *checkpoint);
+		void restore(Checkpoint *checkpoint);
+
 		~Shoe();
 
 	private:
 		bool _initialized;		// setup() has been called
-		Card **_cards;			// pointer to all cards, shuffled
-		Card **_draw;			// pointer to the draw cards
+		Card *_cards;			// all cards (one byte each), shuffled
+		Card *_draw;			// pointer to the draw cards
 		uint8_t _numdecks;		// number of decks in the shoe
 		uint16_t _numcards;		// number of cards in shoe
 		uint16_t _numdealt;		// number of cards dealt so far
 		uint16_t _stopper;		// number of cards away from end to stop
+		bool _lazy;				// shuffle as we deal, see deal()
+		Random _random;			// random number generator
 };
 
-// ShoeShuffleCompare is suitable for passing to qsort() and compares
-// the weights of each card
-int ShoeShuffleCompare(const void *card1, const void *card2);
-
 #endif // SHOE_H
@@ -0,0 +1,36 @@
+// Blackjack Simulation : Shutdown
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.  See the included file 'COPYING'
+// for more information.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// Graceful shutdown on SIGINT or SIGTERM, see Shutdown.h.
+
+#include <signal.h>
+#include "Shutdown.h"
+
+std::atomic<bool> shutdownRequested(false);
+
+// shutdownHandler: ask the tables to stop, and let the next signal stop
+//                  the program at once.  (only async-signal-safe calls
+//                  belong in here.)
+static void shutdownHandler(int sig)
+{
+	signal(sig, SIG_DFL);
+
+	shutdownRequested.store(true);
+}
+
+// CatchShutdownSignals: install the handler for SIGINT and SIGTERM
+void CatchShutdownSignals()
+{
+	signal(SIGINT, shutdownHandler);
+	signal(SIGTERM, shutdownHandler);
+}
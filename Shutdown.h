@@ -0,0 +1,46 @@
+// Blackjack Simulation : Shutdown
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.  See the included file 'COPYING'
+// for more information.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// Graceful shutdown - once CatchShutdownSignals() is called, the first
+// SIGINT (^C) or SIGTERM doesn't stop the program.  The signal handler
+// only sets a flag, which the tables check between rounds (see
+// Table::loop), so the rounds being played are finished and the final
+// report is written as if the run had ended normally.  The handler puts
+// the default back, so a second signal stops the program at once.
+
+#ifndef SHUTDOWN_H
+#define SHUTDOWN_H
+
+#include <atomic>
+
+// catch SIGINT and SIGTERM
+void CatchShutdownSignals();
+
+// true once a shutdown signal has arrived
+inline bool ShutdownRequested();
+
+
+//
+// inline function definition
+//
+
+// set by the signal handler - an atomic flag is safe to set from a
+// signal handler and to read from any thread
+extern std::atomic<bool> shutdownRequested;
+
+inline bool ShutdownRequested()
+{
+	return shutdownRequested.load(std::memory_order_relaxed);
+}
+
+#endif // SHUTDOWN_H
@@ -0,0 +1,297 @@
+// Blackjack Simulation : Simulation
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.  See the included file 'COPYING'
+// for more information.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// This is a parallel simulation runner.  It splits a run into a number
+// of independent "shards" - each is its own Table (with its own Shoe,
+// Player, Statistics and random number generator) running on its own
+// thread.  Shards share nothing while they run, so the run scales with
+// the number of cores.  When every shard has finished, the tables are
+// merged into the first one for a single combined report.
+//
+// Every shard uses the same seed with its own random number stream (the
+// shard number), so a run is reproducible given its seed and number of
+// shards.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <chrono>
+#include "Util.h"
+#include "Assert.h"
+#include "Simulation.h"
+#include "Table.h"
+#include "Snapshot.h"
+#include "Strategy.h"
+#include "StrategyLookup.h"
+#include "Checkpoint.h"
+
+Simulation::Simulation(const char *strategyType, uint16_t shards,
+ uint64_t seed) : _failed(false)
+{
+	// make sure the strategy exists before we start any threads - this
+	// throws on an unknown strategy name, just like Player would
+	delete StrategyLookup(strategyType);
+
+	// one shard per hardware thread, unless we were told otherwise
+	if(shards == 0)
+		shards = (uint16_t)std::thread::hardware_concurrency();
+
+	if(shards == 0)
+		shards = 1;
+
+	_strategyType = strategyType;
+	_shards = shards;
+	_seed = seed;
+	_maxHands = 0;
+	_maxSeconds = 0;
+	_elapsed = 0;
+	_lazyShuffle = false;
+	_checkpointPath = NULL;
+	_checkpointInterval = 0;
+	_resume = false;
+	_historyPath = NULL;
+
+	_tables = new Table*[_shards];
+
+	for(uint16_t i = 0; i < _shards; i++)
+		_tables[i] = NULL;
+}
+
+// run: start a thread for each shard and wait for them all to finish,
+//      then merge every shard's results into the first table
+bool Simulation::run(uint64_t maxHands, uint32_t maxSeconds)
+{
+	std::thread **threads;
+
+	_maxHands = maxHands;
+	_maxSeconds = maxSeconds;
+
+	// a checkpoint for a shard past the last one means the run we're
+	// resuming had more shards than this one
+	if(_resume)
+	{
+		char *path = getShardPath(_checkpointPath, _shards);
+		FILE *fptr = fopen(path, "rb");
+
+		if(fptr != NULL)
+		{
+			fprintf(stderr, "%s: checkpoint is from a run with more shards.\n",
+			 path);
+
+			fclose(fptr);
+			delete [] path;
+
+			return false;
+		}
+
+		delete [] path;
+	}
+
+	threads = new std::thread*[_shards];
+
+	std::chrono::steady_clock::time_point start =
+	 std::chrono::steady_clock::now();
+
+	for(uint16_t i = 0; i < _shards; i++)
+		threads[i] = new std::thread(runShard, this, i);
+
+	for(uint16_t i = 0; i < _shards; i++)
+	{
+		threads[i]->join();
+		delete threads[i];
+	}
+
+	delete [] threads;
+
+	_elapsed = std::chrono::duration<double>(
+	 std::chrono::steady_clock::now() - start).count();
+
+	// reduce the shards into the first table, in shard order so that
+	// the combined result doesn't depend on thread scheduling
+	for(uint16_t i = 1; i < _shards; i++)
+	{
+		if(_tables[0] != NULL && _tables[i] != NULL)
+			_tables[0]->merge(_tables[i]);
+	}
+
+	return !_failed.load();
+}
+
+// runShard: build a table for a single shard and play its share of the
+//           hand budget.  the table is built on the thread that plays
+//           it, so that it (and its random number generator) belong to
+//           that thread alone.
+void Simulation::runShard(Simulation *simulation, uint16_t shard)
+{
+	uint16_t shards = simulation->_shards;
+	uint64_t maxHands = simulation->_maxHands;
+	Table *table;
+
+	// each shard gets an even share of the hand budget, with the
+	// first few shards picking up the remainder
+	if(maxHands > 0)
+		maxHands = (maxHands / shards) + ((shard < maxHands % shards) ? 1 : 0);
+
+	// every shard shares the seed but gets its own random number stream
+	try {
+		table = new Table(simulation->_seed, shard);
+		table->addPlayer(simulation->_strategyType);
+	}
+	catch(...) {
+		fprintf(stderr, "Could not create table for shard %d.\n", shard);
+		simulation->_failed.store(true);
+		return;
+	}
+
+	simulation->_tables[shard] = table;
+
+	if(simulation->_lazyShuffle)
+		table->setLazyShuffle();
+
+	// carry on from this shard's checkpoint, and keep checkpointing
+	if(simulation->_checkpointPath != NULL)
+	{
+		char *path = getShardPath(simulation->_checkpointPath, shard);
+
+		if(simulation->_resume)
+		{
+			try {
+				Checkpoint checkpoint;
+
+				checkpoint.load(path);
+				table->restore(&checkpoint);
+			}
+			catch(std::exception &e) {
+				fprintf(stderr, "%s: %s.\n", path, e.what());
+				simulation->_failed.store(true);
+
+				delete [] path;
+				return;
+			}
+		}
+
+		table->setCheckpoint(path, simulation->_checkpointInterval);
+
+		delete [] path;
+	}
+
+	// the history carries on from the checkpoint, too
+	if(simulation->_historyPath != NULL)
+	{
+		char *path = getShardPath(simulation->_historyPath, shard);
+
+		try {
+			table->setHistory(path, simulation->_resume);
+		}
+		catch(std::exception &e) {
+			fprintf(stderr, "%s: %s.\n", path, e.what());
+			simulation->_failed.store(true);
+
+			delete [] path;
+			return;
+		}
+
+		delete [] path;
+	}
+
+	// a shard with nothing to do would otherwise play forever
+	if(simulation->_maxHands > 0 && maxHands == 0)
+		return;
+
+	table->loop(maxHands, simulation->_maxSeconds);
+}
+
+// report: write the combined statistics for every shard, followed by
+//         the throughput of the run
+void Simulation::report(FILE *fptr)
+{
+	if(_tables[0] == NULL)
+		return;
+
+	_tables[0]->report(fptr);
+
+	uint64_t hands = _tables[0]->handsDealt();
+
+	fprintf(fptr,
+	 "      HANDS DEALT: %llu,  SHARDS: %d,  ELAPSED: %.2fs,  HANDS/SEC: %.0f\n",
+	 (unsigned long long)hands, _shards, _elapsed,
+	 (_elapsed > 0) ? (double)hands / _elapsed : 0.0);
+
+	fprintf(fptr, "      SEED: %llu\n", (unsigned long long)_seed);
+}
+
+// snapshot: record the combined results of the run, and how it was
+//           set up, in the snapshot
+void Simulation::snapshot(Snapshot *snapshot)
+{
+	if(_tables[0] == NULL)
+		return;
+
+	snapshot->record(_strategyType, _seed, _shards, _lazyShuffle,
+	 _tables[0]->handsDealt(), _tables[0]->getPlayer(0));
+}
+
+// setLazyShuffle: have every shard's shoe shuffle the cards as they are
+//                 dealt, see Shoe.h
+void Simulation::setLazyShuffle(bool lazy)
+{
+	_lazyShuffle = lazy;
+}
+
+// setCheckpoint: checkpoint every shard to its own file (see
+//                getShardPath) every interval seconds, and resume
+//                from those files if we're asked to
+void Simulation::setCheckpoint(const char *path, uint32_t interval,
+ bool resume)
+{
+	_checkpointPath = path;
+	_checkpointInterval = interval;
+	_resume = resume;
+}
+
+// setHistory: record every shard's rounds in its own hand history
+//             file (see getShardPath)
+void Simulation::setHistory(const char *path)
+{
+	_historyPath = path;
+}
+
+// getShardPath: returns a shard's own file - the path with the shard
+//               number added
+char *Simulation::getShardPath(const char *path, uint16_t shard)
+{
+	size_t len = strlen(path) + 8;
+	char *shardPath = new char[len];
+
+	snprintf(shardPath, len, "%s.%d", path, shard);
+
+	return shardPath;
+}
+
+// getShards: returns the number of shards in this run
+uint16_t Simulation::getShards()
+{
+	return _shards;
+}
+
+Simulation::~Simulation()
+{
+	for(uint16_t i = 0; i < _shards; i++)
+		delete _tables[i];
+
+	delete [] _tables;
+}
@@ -0,0 +1,101 @@
+// Blackjack Simulation : Simulation
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.  See the included file 'COPYING'
+// for more information.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// This is a parallel simulation runner.  It splits a run into a number
+// of independent "shards" - each is its own Table (with its own Shoe,
+// Player, Statistics and random number generator) running on its own
+// thread.  Shards share nothing while they run, so the run scales with
+// the number of cores.  When every shard has finished, the tables are
+// merged into the first one for a single combined report.
+//
+// Every shard uses the same seed with its own random number stream (the
+// shard number), so a run is reproducible given its seed and number of
+// shards.
+//
+// Each shard can checkpoint its table to its own file (the checkpoint
+// path, a dot and the shard number), and a run can be resumed from
+// those checkpoints - given the same seed and number of shards, the
+// resumed run ends up exactly where an uninterrupted one would.
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include <atomic>
+#include "Util.h"
+#include "Assert.h"
+#include "Table.h"
+#include "Snapshot.h"
+
+class Simulation
+{
+	public:
+		// shards of zero means one per hardware thread
+		Simulation(const char *strategyType, uint16_t shards,
+		 uint64_t seed);
+
+		// play the hand budget (split evenly across shards) or play
+		// until the time budget has elapsed.  returns false if any
+		// shard couldn't be set up (the reason is written to stderr.)
+		bool run(uint64_t maxHands, uint32_t maxSeconds);
+
+		// write the combined report
+		void report(FILE *fptr = stdout);
+
+		// record the combined results in a snapshot (see Snapshot.h)
+		void snapshot(Snapshot *snapshot);
+
+		// number of shards in this run
+		uint16_t getShards();
+
+		// have every shard shuffle lazily (see Shoe.h)
+		void setLazyShuffle(bool lazy = true);
+
+		// checkpoint every shard every interval seconds, and at the
+		// end of the run.  if resume is true, carry on from the last
+		// checkpoints instead of starting fresh.
+		void setCheckpoint(const char *path, uint32_t interval,
+		 bool resume = false);
+
+		// record every shard's rounds in a hand history (see
+		// HandHistory.h) at <path>.<shard>
+		void setHistory(const char *path);
+
+		~Simulation();
+
+	private:
+		// thread entry point - builds and runs a single table
+		static void runShard(Simulation *simulation, uint16_t shard);
+
+		// a shard's own file, <path>.<shard> (to be deleted by the
+		// caller)
+		static char *getShardPath(const char *path, uint16_t shard);
+
+		const char *_strategyType;	// strategy name for every player
+		uint16_t _shards;			// number of tables / threads
+		uint64_t _seed;				// seed for the shards
+		uint64_t _maxHands;			// total hand budget (or 0)
+		uint32_t _maxSeconds;		// time budget (or 0)
+		double _elapsed;			// wall-clock seconds for run()
+		bool _lazyShuffle;			// shuffle as the cards are dealt
+		const char *_checkpointPath;	// checkpoint file (or NULL)
+		uint32_t _checkpointInterval;	// seconds between checkpoints
+		bool _resume;				// resume from the checkpoints
+		const char *_historyPath;	// hand history file (or NULL)
+		std::atomic<bool> _failed;	// a shard couldn't be set up
+		Table **_tables;			// one table per shard
+};
+
+#endif // SIMULATION_H
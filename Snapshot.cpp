@@ -0,0 +1,161 @@
+// Blackjack Simulation : Snapshot
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.  See the included file 'COPYING'
+// for more information.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// This is a snapshot of the results of a run.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <sys/types.h>
+#include <exception>
+#include <stdexcept>
+#include "Util.h"
+#include "Assert.h"
+#include "Snapshot.h"
+#include "MappedFile.h"
+#include "Player.h"
+#include "Statistics.h"
+
+const char Snapshot::magic[8] = { 'B', 'J', 'S', 'N', 'A', 'P', '\r', '\n' };
+
+Snapshot::Snapshot()
+{
+	memset(&_data, 0, sizeof(_data));
+
+	memcpy(_data.magic, magic, sizeof(_data.magic));
+	_data.version = version;
+	_data.size = sizeof(SnapshotData);
+	_data.byteOrder = byteOrder;
+	_data.dealerCards = Statistics::dealerCards;
+	_data.handClasses = Statistics::handClasses;
+	_data.outcomes = 3;
+}
+
+// record: record the results of a finished run, replacing anything
+//         already in the snapshot
+void Snapshot::record(const char *strategy, uint64_t seed, uint16_t shards,
+ bool lazyShuffle, uint64_t handsDealt, Player *player)
+{
+	ASSERT((strategy != NULL && player != NULL));
+
+	strcpy_s(_data.strategy, sizeof(_data.strategy), strategy);
+	_data.seed = seed;
+	_data.shards = shards;
+	_data.lazyShuffle = lazyShuffle ? 1 : 0;
+	_data.snapshots = 1;
+
+	_data.handsDealt = handsDealt;
+	_data.handsPlayed = player->handsPlayed();
+	_data.buyin = player->getBuyin();
+	_data.bankroll = player->getBankroll();
+	_data.bankrollChange = player->getBankrollChange();
+
+	player->getStatistics()->getCounts(_data.counts);
+}
+
+// merge: add another snapshot's results into this one.  if this one
+//        is empty, it takes the other's setup too.
+void Snapshot::merge(const SnapshotData *other)
+{
+	ASSERT(other != NULL);
+
+	if(_data.snapshots == 0)
+	{
+		memcpy(_data.strategy, other->strategy, sizeof(_data.strategy));
+		_data.seed = other->seed;
+		_data.shards = other->shards;
+		_data.lazyShuffle = other->lazyShuffle;
+	}
+	else if(strncmp(_data.strategy, other->strategy,
+	 sizeof(_data.strategy)) != 0)
+		throw std::invalid_argument("snapshots are of different strategies");
+
+	_data.snapshots += other->snapshots;
+
+	_data.handsDealt += other->handsDealt;
+	_data.handsPlayed += other->handsPlayed;
+	_data.buyin += other->buyin;
+	_data.bankroll += other->bankroll;
+	_data.bankrollChange += other->bankrollChange;
+
+	// keep the change in cents
+	_data.bankroll += _data.bankrollChange / 100;
+	_data.bankrollChange %= 100;
+
+	for(int i = 0; i < Statistics::dealerCards; i++)
+	{
+		for(int j = 0; j < Statistics::handClasses; j++)
+		{
+			for(int k = 0; k < 3; k++)
+				_data.counts[i][j][k] += other->counts[i][j][k];
+		}
+	}
+}
+
+// validate: make sure that data is a snapshot in the format we write,
+//           and return it
+const SnapshotData *Snapshot::validate(const void *data, size_t size)
+{
+	const SnapshotData *snapshot = (const SnapshotData *)data;
+
+	if(data == NULL || size < sizeof(snapshot->magic) ||
+	 memcmp(snapshot->magic, magic, sizeof(snapshot->magic)) != 0)
+		throw std::runtime_error("not a snapshot");
+
+	if(size < offsetof(SnapshotData, dealerCards))
+		throw std::runtime_error("snapshot is truncated");
+
+	if(snapshot->byteOrder != byteOrder)
+		throw std::runtime_error("snapshot has a different byte order");
+
+	if(snapshot->version != version)
+		throw std::runtime_error("snapshot is a different version");
+
+	if(snapshot->size != sizeof(SnapshotData) ||
+	 size != sizeof(SnapshotData))
+		throw std::runtime_error("snapshot is the wrong size");
+
+	if(snapshot->dealerCards != Statistics::dealerCards ||
+	 snapshot->handClasses != Statistics::handClasses ||
+	 snapshot->outcomes != 3)
+		throw std::runtime_error("snapshot has a different layout");
+
+	return snapshot;
+}
+
+// write: write the snapshot atomically (see MappedFile.h), so that the
+//        file at path is always a whole snapshot
+void Snapshot::write(const char *path)
+{
+	if(!WriteFileAtomic(path, &_data, sizeof(_data)))
+		throw std::runtime_error("could not write snapshot");
+}
+
+// report: write the statistics and totals of the snapshot
+void Snapshot::report(FILE *fptr)
+{
+	Statistics statistics;
+
+	statistics.merge(_data.counts);
+	statistics.dump(_data.handsPlayed, _data.buyin, _data.bankroll, fptr);
+
+	fprintf(fptr, "      HANDS DEALT: %llu,  SNAPSHOTS: %u,  STRATEGY: %s\n",
+	 (unsigned long long)_data.handsDealt, _data.snapshots, _data.strategy);
+}
+
+// getData: returns the snapshot, as it's written to disk
+const SnapshotData *Snapshot::getData()
+{
+	return &_data;
+}
@@ -0,0 +1,105 @@
+// Blackjack Simulation : Snapshot
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.  See the included file 'COPYING'
+// for more information.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// This is a snapshot of the results of a run: the raw outcome counts
+// from the statistics, the player's totals and how the run was set up.
+// Unlike the report, snapshots keep everything needed to combine runs,
+// so a long sweep can be run as many separate processes (or machines)
+// and reduced into one result afterward.
+//
+// A snapshot is written to disk as a SnapshotData, exactly as it is in
+// memory, so a file can be mapped (see MappedFile.h) and used in place.
+// Files are written in the byte order of the machine that wrote them -
+// validate() refuses one with a different byte order, or a different
+// version or layout, rather than misreading it.  The file is written
+// to a temporary name and renamed into place, so a reader never sees a
+// partly-written snapshot.
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include <stdint.h>
+#include "Util.h"
+#include "Assert.h"
+#include "Player.h"
+#include "Statistics.h"
+
+// the snapshot as it's laid out on disk - every field is naturally
+// aligned, so there's no padding
+struct SnapshotData
+{
+	char magic[8];					// Snapshot::magic
+	uint32_t version;				// Snapshot::version
+	uint32_t size;					// sizeof(SnapshotData)
+	uint32_t byteOrder;				// Snapshot::byteOrder, as written
+	uint8_t dealerCards;			// Statistics::dealerCards
+	uint8_t handClasses;			// Statistics::handClasses
+	uint8_t outcomes;				// win, push, loss
+	uint8_t lazyShuffle;			// the run shuffled lazily
+
+	// how the run was set up (for a reduced snapshot, the first run)
+	char strategy[256];				// strategy name (or chart path)
+	uint64_t seed;					// random number seed
+	uint32_t shards;				// number of shards
+	uint32_t snapshots;				// number of runs in this snapshot
+
+	// the results
+	uint64_t handsDealt;			// rounds dealt
+	uint64_t handsPlayed;			// hands played by the player
+	uint64_t buyin;					// total bought in
+	uint64_t bankroll;				// total bankroll, in dollars
+	uint64_t bankrollChange;		// and cents
+	uint64_t counts[Statistics::dealerCards][Statistics::handClasses][3];
+};
+
+class Snapshot
+{
+	public:
+		static const char magic[8];
+		static const uint32_t version = 1;
+		static const uint32_t byteOrder = 0x01020304;
+
+		// an empty snapshot (of no runs), to merge others into
+		Snapshot();
+
+		// record the results of a run: the player's totals and
+		// statistics, and how the run was set up
+		void record(const char *strategy, uint64_t seed, uint16_t shards,
+		 bool lazyShuffle, uint64_t handsDealt, Player *player);
+
+		// add another snapshot's results into this one - throws
+		// std::invalid_argument if it's of a different strategy
+		void merge(const SnapshotData *other);
+
+		// check that size bytes of data (eg, a mapped file) are a
+		// snapshot that we can read, and return it - throws
+		// std::runtime_error if they're not
+		static const SnapshotData *validate(const void *data, size_t size);
+
+		// write the snapshot to the file at path - throws
+		// std::runtime_error if it can't be written
+		void write(const char *path);
+
+		// write the report for this snapshot
+		void report(FILE *fptr = stdout);
+
+		const SnapshotData *getData();
+
+	private:
+		SnapshotData _data;
+};
+
+#endif // SNAPSHOT_H
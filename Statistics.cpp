@@ -27,40 +27,31 @@
 #include "Statistics.h"
 #include "Hand.h"
 #include "Player.h"
+#include "Checkpoint.h"
 
 Statistics::Statistics()
 {
-	// NOTE: we initialize these arrays with some padding -- we access
-	// each card with its rank - ie, a 2 is at index 2 - so there's no
-	// card at index 0.  So, we could either subtract 1 from the card
-	// and confuse ourselves (ie, card 2 is at index 1) or waste a few
-	// bytes.  Code cleanliness is worth a few bytes, since nobody
-	// really wants an embedded version of this (I hope.)
-
 	// we keep the statistics array so that we can lookup the player's
 	// hand by either pair, ace + kicker or total sum of cards and
-	// dealer's showing card.  Examples:
-	// dealer=6 player=8/8 win =  _stats[6][8][8][Win]
-	// dealer=9 player=A/5 loss = _stats[9][1][5][Loss]
-	// dealer=A player=9/8 push = _stats[11][17][0][Push]
+	// dealer's showing card.  Only the hands that can be dealt get a
+	// place in the array (see getClass), so it stays small and quick
+	// to merge.  The counts are 64 bits, so they never wrap around.
+	// Examples:
+	// dealer=6 player=8/8 win =  _stats[5][getClass(8, 8)][Win]
+	// dealer=9 player=A/5 loss = _stats[8][getClass(1, 5)][Loss]
+	// dealer=A player=9/8 push = _stats[0][getClass(17, 0)][Push]
 
 	// loop through each card that the dealer could have showing
-	for(int i = 0; i < 12; i++)
+	for(int i = 0; i < dealerCards; i++)
 	{
-		// loop through each single card and total that could be had
-		// by the player.
-		for(int j = 0; j < 22; j++)
+		// loop through each class of hand the player could have
+		for(int j = 0; j < handClasses; j++)
 		{
-			// loop through each second card that could be had by the
-			// player.
-			for(int k = 0; k < 12; k++)
-			{
-				// loop through each possible outcome (Win, Push, Loss)
-				for(int l = 0; l < 3; l++)
-
-					// and zero out the stat count for that
-					_stats[i][j][k][l] = 0;
-			}
+			// loop through each possible outcome (Win, Push, Loss)
+			for(int k = 0; k < 3; k++)
+
+				// and zero out the stat count for that
+				_stats[i][j][k] = 0;
 		}
 	}
 }
@@ -68,22 +59,14 @@ Statistics::Statistics()
 // write: increment the outcome count for this dealer show card and player
 //        initial deal.  ie, if the dealer had a 7 showing, the player's
 //        initial cards were 9 8 and the player won, we would do:
-//        _stats[7][17][0][Push]++;
-void Statistics::write(LinkedList<Card *> *dealerCards,
- LinkedList<Card *> *playerCards, HandOutcome result)
+//        _stats[6][getClass(17, 0)][Win]++;
+void Statistics::write(Card dealerCard, Card playerCard1, Card playerCard2,
+ HandOutcome result)
 {
 	uint8_t dealerScore, playerScore1, playerScore2;
 
-	// get the player's first two cards (initial deal)
-	Card *playerCard1 = playerCards->fetchFront();
-	Card *playerCard2 = playerCards->fetchNumber(2);
-
-	// get the rank of their cards
-	char playerRank1 = playerCard1->getRank();
-	char playerRank2 = playerCard2->getRank();
-
 	// determine how to arrange the dealer score
-	dealerScore = getScore(dealerCards->fetchFront());
+	dealerScore = getScore(dealerCard);
 
 	// find out if we have matching cards - they get their statistics
 	// computed differently, since most strategies have different play
@@ -97,9 +80,9 @@ void Statistics::write(LinkedList<Card *> *dealerCards,
 	// find out if we have a single ace - they also get their statistics
 	// computed differently, since most strategies have different play
 	// for soft hands (ie, we may sometimes double)
-	else if(playerRank1 == 'A' || playerRank2 == 'A')
+	else if(playerCard1.isAce() || playerCard2.isAce())
 	{
-		Card *otherCard = (playerRank1 == 'A') ? playerCard2 : playerCard1;
+		Card otherCard = playerCard1.isAce() ? playerCard2 : playerCard1;
 
 		playerScore1 = 1;
 		playerScore2 = getScore(otherCard);
@@ -114,52 +97,98 @@ void Statistics::write(LinkedList<Card *> *dealerCards,
 	}
 
 	// increment the count for this result
-	_stats[dealerScore][playerScore1][playerScore2][result]++;
+	_stats[dealerScore - 1][getClass(playerScore1, playerScore2)][result]++;
 }
 
 // dump: write the statistics to the console (or a file)
 void Statistics::dump(Player *player, FILE *fptr)
 {
-	// clear the screen if we're writing to the console
-	if(fptr == stdout)
-		clear_portable();
+	dump(player->handsPlayed(), player->getBuyin(), player->getBankroll(),
+	 fptr);
+}
 
+// dump: write the statistics to the console (or a file), given the
+//       number of hands played, total buyin and the bankroll
+void Statistics::dump(uint64_t handsPlayed, uint64_t buyin,
+ uint64_t bankroll, FILE *fptr)
+{
 	// this is the dealer's hand
 	fprintf(fptr, "       A      2      3      4      5      6      7      8      9     10\n");
 
 	// write hands without an ace or a split
 	for(int plyr = 5; plyr < 20; plyr++)
-		dumpHand(plyr, 0);
+		dumpHand(plyr, 0, fptr);
 
 	// write hands with an ace
 	for(int plyr = 2; plyr < 11; plyr++)
-		dumpHand(1, plyr);
+		dumpHand(1, plyr, fptr);
 
 	// write hands with paired cards
 	for(int plyr = 1; plyr < 11; plyr++)
-		dumpHand(plyr, plyr);
-
-
-	// number of hands played
-	uint32_t handsPlayed = player->handsPlayed();
-
-	// determine the winningness/losingness of this strategy
-	uint32_t buyin = player->getBuyin();
-	uint16_t bankroll = player->getBankroll();
+		dumpHand(plyr, plyr, fptr);
 
 	// amount won
-	int16_t winAmount = (int16_t)(bankroll - buyin);
+	int64_t winAmount = (int64_t)bankroll - (int64_t)buyin;
 
 	// income (payin/payout) per hand
 	double incomePerHand = ((double)winAmount / (double)handsPlayed);
 
 	fprintf(fptr,
-	 "             HANDS PLAYED: %d,  INCOME/HAND: $%f\n",
-	 handsPlayed, incomePerHand);
+	 "             HANDS PLAYED: %llu,  INCOME/HAND: $%f\n",
+	 (unsigned long long)handsPlayed, incomePerHand);
 
 	fprintf(fptr,
-	 "      AMOUNT BOUGHT IN: $%d,  CURRENT BANKROLL: $%d,  WINS: $%d\n",
-	 buyin, bankroll, winAmount);
+	 "      AMOUNT BOUGHT IN: $%llu,  CURRENT BANKROLL: $%llu,  WINS: $%lld\n",
+	 (unsigned long long)buyin, (unsigned long long)bankroll,
+	 (long long)winAmount);
+}
+
+// merge: add the outcome counts from another statistics object into
+//        this one
+void Statistics::merge(const Statistics &other)
+{
+	merge(other._stats);
+}
+
+// getCounts: copy the outcome counts, by dealer card, class of player
+//            hand and outcome
+void Statistics::getCounts(uint64_t counts[dealerCards][handClasses][3])
+ const
+{
+	for(int i = 0; i < dealerCards; i++)
+	{
+		for(int j = 0; j < handClasses; j++)
+		{
+			for(int k = 0; k < 3; k++)
+				counts[i][j][k] = _stats[i][j][k];
+		}
+	}
+}
+
+// merge: add outcome counts, by dealer card, class of player hand and
+//        outcome, into this object
+void Statistics::merge(const uint64_t counts[dealerCards][handClasses][3])
+{
+	for(int i = 0; i < dealerCards; i++)
+	{
+		for(int j = 0; j < handClasses; j++)
+		{
+			for(int k = 0; k < 3; k++)
+				_stats[i][j][k] += counts[i][j][k];
+		}
+	}
+}
+
+// save: save the outcome counts
+void Statistics::save(Checkpoint *checkpoint)
+{
+	checkpoint->put(_stats);
+}
+
+// restore: restore the outcome counts from a checkpoint
+void Statistics::restore(Checkpoint *checkpoint)
+{
+	checkpoint->get(_stats);
 }
 
 // dumpHand: write the statistics for a player's hand to the console
@@ -182,18 +211,20 @@ void Statistics::dumpHand(uint8_t card1, uint8_t card2, FILE *fptr)
 	else
 		fprintf(fptr, "%2d/%-2d ", card1, card2);
 
+	uint8_t handClass = getClass(card1, card2);
+
 	// loop through each dealer card
-	for(int dlr = 1; dlr < 11; dlr++)
+	for(int dlr = 0; dlr < dealerCards; dlr++)
 	{
 		// total number of hands played is wins + losses + pushes
-		int total = _stats[dlr][card1][card2][Win] +
-		 _stats[dlr][card1][card2][Loss] +
-		 _stats[dlr][card1][card2][Push];
+		uint64_t total = _stats[dlr][handClass][Win] +
+		 _stats[dlr][handClass][Loss] +
+		 _stats[dlr][handClass][Push];
 
 		// we'll consider wins or pushes as "successful" hands since
 		// we didn't lose money
-		int win = _stats[dlr][card1][card2][Win] +
-		 _stats[dlr][card1][card2][Push];
+		uint64_t win = _stats[dlr][handClass][Win] +
+		 _stats[dlr][handClass][Push];
 
 
 		// no hands were played with these two cards
@@ -208,8 +239,8 @@ void Statistics::dumpHand(uint8_t card1, uint8_t card2, FILE *fptr)
 		// otherwise, compute the successfulness of the hand
 		else
 		{
-			// we use a float here, and cutoff at 1 decimal place
-			float winPercent = (((float)win / (float)total) * 100);
+			// we cutoff at 1 decimal place
+			double winPercent = (((double)win / (double)total) * 100);
 
 			fprintf(fptr, "%4.1f%%  ", winPercent);
 		}
@@ -220,26 +251,34 @@ void Statistics::dumpHand(uint8_t card1, uint8_t card2, FILE *fptr)
 
 // getScore: gets the score suitable for putting in the array
 //           (in particular, A = 1)
-uint8_t Statistics::getScore(Card *card)
+uint8_t Statistics::getScore(Card card)
 {
-	uint8_t score = 0;
-
-	char rank = card->getRank();
-
-	// A = 1 instead of 11, to put in an array
-	if(rank == 'A')
-		score = 1;
+	return card.getValue();
+}
 
-	// 10 cards
-	else if(rank == 'T' || rank == 'J' || rank == 'Q' || rank == 'K')
-		score = 10;
+// getClass: gets the index in the statistics array of a player's hand,
+//           given as a pair (both scores the card, A = 1), an ace and
+//           kicker (1 and the kicker) or a total (and 0).  hard totals
+//           5 - 19 come first, then A/2 - A/10, then A/A - 10/10.
+uint8_t Statistics::getClass(uint8_t score1, uint8_t score2)
+{
+	// a pair
+	if(score1 == score2)
+	{
+		ASSERT((score1 >= 1 && score1 <= 10));
+		return (15 + 9 + (score1 - 1));
+	}
 
-	// otherwise, we have a char like '6', so subtracting 48 gives us
-	// the decimal value (ie, '6' = ASCII 54, subtracting 48 gives us 6).
-	else
-		score = rank - 48;
+	// an ace with a kicker
+	else if(score1 == 1)
+	{
+		ASSERT((score2 >= 2 && score2 <= 10));
+		return (15 + (score2 - 2));
+	}
 
-	return score;
+	// a total
+	ASSERT((score2 == 0 && score1 >= 5 && score1 <= 19));
+	return (score1 - 5);
 }
 
 Statistics::~Statistics()
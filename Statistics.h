@@ -33,31 +33,57 @@
 
 // empty declaration to avoid circular dependencies
 class Player;
+class Checkpoint;
 
 class Statistics
 {
 	public:
+		// the dealer's up cards (ace through ten) and the classes of
+		// player hand (see getClass) that we keep statistics for
+		static const uint8_t dealerCards = 10;
+		static const uint8_t handClasses = 34;
+
 		Statistics();
 
-		// writes the outcome of a hand to the statistics array
-		void write(LinkedList<Card *> *dealerCards,
-		 LinkedList<Card *> *playerCards, HandOutcome result);
+		// writes the outcome of a hand to the statistics array, by
+		// the dealer's up card and the player's first two cards
+		void write(Card dealerCard, Card playerCard1, Card playerCard2,
+		 HandOutcome result);
 
 		// dump statistics to a file (or console)
 		void dump(Player *player, FILE *fptr = stdout);
 
+		// dump statistics with the given player totals
+		void dump(uint64_t handsPlayed, uint64_t buyin, uint64_t bankroll,
+		 FILE *fptr = stdout);
+
+		// add the counts from another statistics object into this one
+		void merge(const Statistics &other);
+
+		// copy the raw outcome counts out, or add raw counts in (eg,
+		// from a snapshot, see Snapshot.h)
+		void getCounts(uint64_t counts[dealerCards][handClasses][3]) const;
+		void merge(const uint64_t counts[dealerCards][handClasses][3]);
+
+		// save or restore the counts (see Checkpoint.h)
+		void save(Checkpoint *checkpoint);
+		void restore(Checkpoint *checkpoint);
+
 		~Statistics();
 
 	private:
-		uint8_t getScore(Card *card);
+		uint8_t getScore(Card card);
+
+		// the index of a player's hand in the statistics array
+		static uint8_t getClass(uint8_t score1, uint8_t score2);
 
 		// dump hand statistics by player card1 / player card 2
 		void dumpHand(uint8_t card1, uint8_t card2, FILE *fptr = stdout);
 
-		// the statistics array by dealer card, player cards, outcome.
-		// eg:  Dealer has 9 showing, player has 4/4 and player Lost:
-		// _stats[9][4][4][Loss]
-		uint16_t _stats[12][22][12][3];
+		// the statistics array by dealer card, class of player hand,
+		// outcome.  eg:  Dealer has 9 showing, player has 4/4 and
+		// player Lost:  _stats[8][getClass(4, 4)][Loss]
+		uint64_t _stats[dealerCards][handClasses][3];
 };
 
 #endif // STATISTICS_H
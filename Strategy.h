@@ -33,6 +33,9 @@
 
 typedef enum { None, Stand, Hit, Double, Split } PlayAction;
 
+// empty declaration to avoid including the threading headers
+class Checkpoint;
+
 
 class Strategy
 {
@@ -42,16 +45,14 @@ class Strategy
 
 		// get the bet for the next play - bet may change for
 		// interactive strategies
-		virtual uint8_t getBet(uint16_t bank, uint16_t cardsLeft) = 0;
+		virtual uint8_t getBet(uint32_t bank, uint16_t cardsLeft) = 0;
 
 		// get play action (first decl is for the dealer)
-		virtual PlayAction play(LinkedList<Card *> *cardList) = 0;
-		virtual PlayAction play(LinkedList<Card *> *cardList,
-		 LinkedList<Card *> *dealerCards) = 0;
+		virtual PlayAction play(Hand *hand) = 0;
+		virtual PlayAction play(Hand *hand, Hand *dealer) = 0;
 
 		// offer insurance
-		virtual bool insure(LinkedList<Card *> *dealerCards,
-		 LinkedList<Card *> *cardList) = 0;
+		virtual bool insure(Hand *dealer, Hand *hand) = 0;
 
 		// notify of blackjacks - useful for interactive strategies
 		// or maybe for keeping statistics when counting cards
@@ -64,9 +65,19 @@ class Strategy
 
 		// summarize the hand at the end of play - useful for
 		// interactive strategies
-		virtual void summarize(LinkedList<Card *> *dealerCards,
+		virtual void summarize(Hand *dealer,
 		 LinkedList<Hand *> *hands)
-		{ dealerCards = dealerCards; hands = hands; }
+		{ dealer = dealer; hands = hands; }
+
+		// save or restore anything the strategy needs to carry on
+		// exactly where it left off, like the count (see Checkpoint.h)
+		virtual void saveState(Checkpoint *checkpoint)
+		{ checkpoint = checkpoint; }
+		virtual void loadState(Checkpoint *checkpoint)
+		{ checkpoint = checkpoint; }
+
+		// strategies are deleted through this base class
+		virtual ~Strategy() { }
 };
 
 #endif // STRATEGY_H
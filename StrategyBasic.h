@@ -12,7 +12,8 @@
 // GNU General Public License for more details.
 //
 // This is the basic blackjack strategy as defined at
-// http://wizardofodds.com/games/blackjack.
+// http://wizardofodds.com/games/blackjack.  The strategy is just its
+// chart, see StrategyTable.h
 
 #ifndef STRATEGYBASIC_H
 #define STRATEGYBASIC_H
@@ -22,26 +23,16 @@
 #include <sys/types.h>
 #include "Util.h"
 #include "Assert.h"
-#include "LinkedList.h"
-#include "Player.h"
-#include "Card.h"
-#include "Strategy.h"
+#include "DecisionTable.h"
+#include "StrategyTable.h"
 
+// the basic strategy chart, for other strategies that play by it
+extern const DecisionTable basicStrategyTable;
 
-class StrategyBasic : public Strategy
+class StrategyBasic : public StrategyTable
 {
 	public:
 		StrategyBasic();
-		uint16_t getBuyin();
-		uint8_t getBet(uint16_t bank, uint16_t cardsLeft);
-		PlayAction play(LinkedList<Card *> *cardList);
-		PlayAction play(LinkedList<Card *> *cardList,
-		 LinkedList<Card *> *dealerCards);
-		bool insure(LinkedList<Card *> *dealerCards,
-		 LinkedList<Card *> *cardList);
-
-	private:
-		uint8_t _bet;
 };
 
 #endif // STRATEGYBASIC_H
@@ -12,7 +12,10 @@
 // GNU General Public License for more details.
 //
 // This is the basic blackjack strategy as defined at
-// http://wizardofodds.com/games/blackjack.
+// http://wizardofodds.com/games/blackjack, with simple card counting
+// as described at http://www.allaboutblackjack.com/cardcounting.html
+// It plays by the basic strategy chart, but bets (and insures) by the
+// count.
 
 #ifndef STRATEGYCARDCOUNT_H
 #define STRATEGYCARDCOUNT_H
@@ -26,30 +29,15 @@
 #include "Player.h"
 #include "Card.h"
 #include "Strategy.h"
+#include "StrategyTable.h"
 
 
-class StrategyCardCount : public Strategy
+class StrategyCardCount : public StrategyTable
 {
 	public:
 		StrategyCardCount();
-		uint16_t getBuyin();
-		uint8_t getBet(uint16_t bank, uint16_t cardsLeft);
-		void notifyShuffle(void);
-		PlayAction play(LinkedList<Card *> *cardList);
-		PlayAction play(LinkedList<Card *> *cardList,
-		 LinkedList<Card *> *dealerCards);
-		bool insure(LinkedList<Card *> *dealerCards,
-		 LinkedList<Card *> *cardList);
-		void summarize(LinkedList<Card *> *dealerCards,
-		 LinkedList<Hand *> *hands);
-
-	private:
-		void updateWeight(Card *card);
-		float getTrueCount(uint16_t cardsLeft = 0);
-
-		uint8_t _bet;
-		int32_t _weight;
-		uint16_t _cardsLeft;
+		uint8_t getBet(uint32_t bank, uint16_t cardsLeft);
+		bool insure(Hand *dealer, Hand *hand);
 };
 
 #endif // STRATEGYCARDCOUNT_H
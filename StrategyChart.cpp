@@ -0,0 +1,95 @@
+// Blackjack Simulation : StrategyChart
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.  See the included file 'COPYING'
+// for more information.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// This is a strategy which plays from a chart in a file.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <exception>
+#include <stdexcept>
+#include "Util.h"
+#include "Assert.h"
+#include "StrategyChart.h"
+#include "StrategyTable.h"
+#include "DecisionTable.h"
+
+StrategyChart::StrategyChart(const char *path) : StrategyTable(load(path))
+{
+}
+
+// load: read the chart file at path and compile it into a table.  if
+//       it can't be read or isn't a valid chart, says why on stderr and
+//       throws.
+const DecisionTable *StrategyChart::load(const char *path)
+{
+	DecisionTable *table;
+	FILE *fptr;
+	char *chart;
+	size_t len;
+	size_t line = 0;
+
+	ASSERT(path != NULL);
+
+	if((fptr = fopen(path, "r")) == NULL)
+	{
+		// not being a file is the usual reason a strategy name
+		// isn't found, so only complain about other errors
+		if(errno != ENOENT)
+			fprintf(stderr, "chart %s: %s\n", path, strerror(errno));
+
+		throw std::invalid_argument("could not open chart");
+	}
+
+	chart = new char[maxChartSize + 1];
+	len = fread(chart, 1, maxChartSize + 1, fptr);
+
+	if(ferror(fptr) || len > maxChartSize)
+	{
+		fprintf(stderr, "chart %s: %s\n", path,
+		 ferror(fptr) ? "could not read the chart" : "chart is too large");
+
+		fclose(fptr);
+		delete [] chart;
+
+		throw std::invalid_argument("could not read chart");
+	}
+
+	fclose(fptr);
+	chart[len] = '\0';
+
+	try {
+		table = new DecisionTable(chart, &line);
+	}
+	catch(std::invalid_argument &e) {
+		if(line > 0)
+			fprintf(stderr, "chart %s: %s (line %lu)\n", path, e.what(),
+			 (unsigned long)line);
+		else
+			fprintf(stderr, "chart %s: %s\n", path, e.what());
+
+		delete [] chart;
+		throw;
+	}
+
+	delete [] chart;
+
+	return table;
+}
+
+StrategyChart::~StrategyChart()
+{
+	delete _table;
+}
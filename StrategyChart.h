@@ -0,0 +1,46 @@
+// Blackjack Simulation : StrategyChart
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.  See the included file 'COPYING'
+// for more information.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// This is a strategy which plays from a chart in a file (see
+// DecisionTable.h for the format.)  The chart is read and compiled into
+// its table once, when the strategy is created, so playing a hand costs
+// the same as it does for a built-in chart.
+
+#ifndef STRATEGYCHART_H
+#define STRATEGYCHART_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include "Util.h"
+#include "Assert.h"
+#include "DecisionTable.h"
+#include "StrategyTable.h"
+
+
+class StrategyChart : public StrategyTable
+{
+	public:
+		// load the chart in the file at path - throws if the file
+		// can't be read or isn't a valid chart
+		StrategyChart(const char *path);
+		~StrategyChart();
+
+	private:
+		static const DecisionTable *load(const char *path);
+
+		// largest chart file we'll read
+		static const size_t maxChartSize = 65536;
+};
+
+#endif // STRATEGYCHART_H
@@ -33,7 +33,7 @@ uint16_t StrategyDealerHitsSoft17::getBuyin()
 }
 
 // getBet: returns the amount to bet on a single hand
-uint8_t StrategyDealerHitsSoft17::getBet(uint16_t bank, uint16_t cardsLeft)
+uint8_t StrategyDealerHitsSoft17::getBet(uint32_t bank, uint16_t cardsLeft)
 {
 	// suppress unused warnings
 	bank = bank;
@@ -43,13 +43,13 @@ uint8_t StrategyDealerHitsSoft17::getBet(uint16_t bank, uint16_t cardsLeft)
 }
 
 // play: play for the dealer
-PlayAction StrategyDealerHitsSoft17::play(LinkedList<Card *> *cardList)
+PlayAction StrategyDealerHitsSoft17::play(Hand *hand)
 {
 	// hit on soft 17
-	if (Hand::getScore(cardList) == 17 && Hand::getSoft(cardList))
+	if (hand->getScore() == 17 && hand->getSoft())
 		return Hit;
 
-	else if(Hand::getScore(cardList) >= 17)
+	else if(hand->getScore() >= 17)
 		return Stand;
 
 	// hit on anything lower
@@ -57,22 +57,20 @@ PlayAction StrategyDealerHitsSoft17::play(LinkedList<Card *> *cardList)
 }
 
 // play: play for a player
-PlayAction StrategyDealerHitsSoft17::play(LinkedList<Card *> *cardList,
- LinkedList<Card *> *dealerCards)
+PlayAction StrategyDealerHitsSoft17::play(Hand *hand, Hand *dealer)
 {
 	// suppress unused variable warnings
-	dealerCards = dealerCards;
+	dealer = dealer;
 
-	return play(cardList);
+	return play(hand);
 }
 
 // insure: returns true if player wants insurance
-bool StrategyDealerHitsSoft17::insure(LinkedList<Card *> *dealerCards,
- LinkedList<Card *> *cardList)
+bool StrategyDealerHitsSoft17::insure(Hand *dealer, Hand *hand)
 {
 	// ignore warnings about unused variable
-	dealerCards = dealerCards;
-	cardList = cardList;
+	dealer = dealer;
+	hand = hand;
 
 	// dealer strategy never insures -- (dealer cannot insure anyway)
 	return false;
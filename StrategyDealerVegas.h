@@ -32,12 +32,10 @@ class StrategyDealerVegas : public Strategy
 {
 	public:
 		uint16_t getBuyin();
-		uint8_t getBet(uint16_t bank, uint16_t cardsLeft);
-		PlayAction play(LinkedList<Card *> *cardList);
-		PlayAction play(LinkedList<Card *> *cardList,
-		 LinkedList<Card *> *dealerCards);
-		bool insure(LinkedList<Card *> *dealerCards,
-		 LinkedList<Card *> *cardList);
+		uint8_t getBet(uint32_t bank, uint16_t cardsLeft);
+		PlayAction play(Hand *hand);
+		PlayAction play(Hand *hand, Hand *dealer);
+		bool insure(Hand *dealer, Hand *hand);
 
 	private:
 };
@@ -19,6 +19,7 @@
 #include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/types.h>
 #include <iostream>
 #include <string>
@@ -50,14 +51,14 @@ uint16_t StrategyInteractive::getBuyin()
 }
 
 // getBet: prompts the user and returns the amount to bet on this hand
-uint8_t StrategyInteractive::getBet(uint16_t bank, uint16_t cardsLeft)
+uint8_t StrategyInteractive::getBet(uint32_t bank, uint16_t cardsLeft)
 {
 	uint8_t bet = 0;
 
 	// suppress unused warnings
 	cardsLeft = cardsLeft;
 
-	printf("You have $%d.  ", bank);
+	printf("You have $%u.  ", bank);
 
 	while(bet == 0)
 		bet = getInput("Enter bet amount", _bet);
@@ -69,10 +70,10 @@ uint8_t StrategyInteractive::getBet(uint16_t bank, uint16_t cardsLeft)
 
 // play: player for the dealer - interactive strategy can't be used for
 //       the dealer
-PlayAction StrategyInteractive::play(LinkedList<Card *> *cardList)
+PlayAction StrategyInteractive::play(Hand *hand)
 {
 	// suppress unused variable warnings
-	cardList = cardList;
+	hand = hand;
 
 	// interactive strategy cannot be used for dealer
 	ASSERT(0);
@@ -81,18 +82,17 @@ PlayAction StrategyInteractive::play(LinkedList<Card *> *cardList)
 }
 
 // play: prompts the player and returns way to play
-PlayAction StrategyInteractive::play(LinkedList<Card *> *cardList,
- LinkedList<Card *> *dealerCards)
+PlayAction StrategyInteractive::play(Hand *hand, Hand *dealer)
 {
-	Card *card;
+	Card card;
 	char input = 0;
 	char prompt[128];
 
 	// get the score for this hand
-	uint8_t handScore = Hand::getScore(cardList);
+	uint8_t handScore = hand->getScore();
 
 	// longest hand is used to determine how to pad the display
-	uint8_t longestHand = (cardList->getCount() > 2) ? (uint8_t)cardList->getCount() : 2;
+	uint8_t longestHand = (hand->getCardCount() > 2) ? hand->getCardCount() : 2;
 
 
 	printf("\nYour turn to play:\n");
@@ -103,13 +103,13 @@ PlayAction StrategyInteractive::play(LinkedList<Card *> *cardList,
 	printf("DEALER:  **  ");
 
 	// iterate through dealer's other cards, displaying them
-	while((card = dealerCards->iterate()) != NULL)
-		printf("%c%c  ", card->getRank(), card->getSuit());
+	while((card = dealer->getCards()->iterate()).isValid())
+		printf("%c%c  ", card.getRank(), card.getSuit());
 
 	// pad the display
-	if(dealerCards->getCount() < longestHand)
+	if(dealer->getCardCount() < longestHand)
 	{
-		for(int i = dealerCards->getCount(); i < longestHand; i++)
+		for(int i = dealer->getCardCount(); i < longestHand; i++)
 			printf("    ");
 	}
 	printf("\n");
@@ -118,9 +118,9 @@ PlayAction StrategyInteractive::play(LinkedList<Card *> *cardList,
 	// display the player's cards, iterate through each card, displaying
 	// them
 	printf("PLAYER:  ");
-	while((card = cardList->iterate()) != NULL)
+	while((card = hand->getCards()->iterate()).isValid())
 	{
-		printf("%c%c  ", card->getRank(), card->getSuit());
+		printf("%c%c  ", card.getRank(), card.getSuit());
 	}
 
 
@@ -128,7 +128,7 @@ PlayAction StrategyInteractive::play(LinkedList<Card *> *cardList,
 	printf("[");
 
 	// print soft score, if available
-	if(Hand::getSoft(cardList))
+	if(hand->getSoft())
 		printf("%d/", (handScore - 10));
 
 	printf("%d]\n\n", handScore);
@@ -137,8 +137,8 @@ PlayAction StrategyInteractive::play(LinkedList<Card *> *cardList,
 	// loop until valid play input provided
 	while(input != 'h' && input != 's' && input != 'd' && input != 'p')
 	{
-		bool doubleAllowed = cardList->getCount() == 2;
-		bool splitAllowed = Hand::splitAllowed(cardList);
+		bool doubleAllowed = hand->getCardCount() == 2;
+		bool splitAllowed = hand->splitAllowed();
 
 		// build the prompt for input based on available play
 		strcpy_s(prompt, 128, "Your action:  S)tand, H)it");
@@ -180,10 +180,9 @@ PlayAction StrategyInteractive::play(LinkedList<Card *> *cardList,
 }
 
 // insure: prompts and returns true if dealer wishes to insure their hand
-bool StrategyInteractive::insure(LinkedList<Card *> *dealerCards,
- LinkedList<Card *> *cardList)
+bool StrategyInteractive::insure(Hand *dealer, Hand *hand)
 {
-	Card *card;
+	Card card;
 	char input = 0;
 
 	printf("\nINSURANCE OFFER:\n");
@@ -192,25 +191,25 @@ bool StrategyInteractive::insure(LinkedList<Card *> *dealerCards,
 	printf("DEALER:  * *  ");
 
 	// iterate through dealer's other cards, displaying them
-	while((card = dealerCards->iterate()) != NULL)
-		printf("%c%c  ", card->getRank(), card->getSuit());
+	while((card = dealer->getCards()->iterate()).isValid())
+		printf("%c%c  ", card.getRank(), card.getSuit());
 
 	printf("\n");
 
 
 	// display the player's cards, iterating through each one
 	printf("PLAYER:  ");
-	while((card = cardList->iterate()) != NULL)
-		printf("%c%c  ", card->getRank(), card->getSuit());
+	while((card = hand->getCards()->iterate()).isValid())
+		printf("%c%c  ", card.getRank(), card.getSuit());
 
 	// display the score
-	printf("[%02d]    ", Hand::getScore(cardList));
+	printf("[%02d]    ", hand->getScore());
 
 	printf("\n\n");
 
 
 	// offer insurance
-	const char *prompt = (Hand::getScore(cardList) == 21) ?
+	const char *prompt = (hand->getScore() == 21) ?
 	 "Insure this hand -- take even money?" : "Insure this hand?";
 
 	// loop until they give us a valid answer
@@ -243,20 +242,20 @@ void StrategyInteractive::notifyPlayerBlackjack(void)
 }
 
 // summarize: displays a summary showing the end of the hand
-void StrategyInteractive::summarize(LinkedList<Card *> *dealerCards,
+void StrategyInteractive::summarize(Hand *dealer,
  LinkedList<Hand *> *hands)
 {
 	uint8_t score;
-	Card *card;
+	Card card;
 	Hand *hand;
 	uint8_t handCount = 0;
 
 	// find the greatest number of cards in each hand for padding
-	uint8_t longestHand = (uint8_t)dealerCards->getCount();
+	uint8_t longestHand = dealer->getCardCount();
 
 	while((hand = hands->iterate()) != NULL)
 	{
-		uint8_t cardCount = (uint8_t)hand->getCards()->getCount();
+		uint8_t cardCount = hand->getCardCount();
 
 		// this hand is longer
 		if(cardCount > longestHand)
@@ -269,18 +268,18 @@ void StrategyInteractive::summarize(LinkedList<Card *> *dealerCards,
 
 	// display the dealer cards, iterate through each one
 	printf("DEALER:  ");
-	while((card = dealerCards->iterate()) != NULL)
-		printf("%c%c  ", card->getRank(), card->getSuit());
+	while((card = dealer->getCards()->iterate()).isValid())
+		printf("%c%c  ", card.getRank(), card.getSuit());
 
 	// add some padding so that totals line up in each column
-	if(dealerCards->getCount() < longestHand)
+	if(dealer->getCardCount() < longestHand)
 	{
-		for(int i = dealerCards->getCount(); i < longestHand; i++)
+		for(int i = dealer->getCardCount(); i < longestHand; i++)
 			printf("    ");
 	}
 
 	// display score (or bust)
-	if((score = Hand::getScore(dealerCards)) > 21)
+	if((score = dealer->getScore()) > 21)
 		printf("[BUST]  ");
 	else
 		printf("[%02d]    ", score);
@@ -292,7 +291,6 @@ void StrategyInteractive::summarize(LinkedList<Card *> *dealerCards,
 	while((hand = hands->iterate()) != NULL)
 	{
 		HandOutcome outcome;
-		LinkedList<Card *> *cardList = hand->getCards();
 
 		if(handCount++ == 0)
 			printf("PLAYER:  ");
@@ -300,14 +298,14 @@ void StrategyInteractive::summarize(LinkedList<Card *> *dealerCards,
 			printf("         ");
 
 		// display each card in this hand
-		while((card = cardList->iterate()) != NULL)
-			printf("%c%c  ", card->getRank(), card->getSuit());
+		while((card = hand->getCards()->iterate()).isValid())
+			printf("%c%c  ", card.getRank(), card.getSuit());
 
 		// add some padding, if necessary, so that hand total lines up
 		// in each column
-		if(cardList->getCount() < longestHand)
+		if(hand->getCardCount() < longestHand)
 		{
-			for(int i = cardList->getCount(); i < longestHand; i++)
+			for(int i = hand->getCardCount(); i < longestHand; i++)
 				printf("    ");
 		}
 
@@ -34,16 +34,14 @@ class StrategyInteractive : public Strategy
 	public:
 		StrategyInteractive();
 		uint16_t getBuyin();
-		uint8_t getBet(uint16_t bank, uint16_t cardsLeft);
-		PlayAction play(LinkedList<Card *> *cardList);
-		PlayAction play(LinkedList<Card *> *cardList,
-		 LinkedList<Card *> *dealerCards);
-		bool insure(LinkedList<Card *> *dealerCards,
-		 LinkedList<Card *> *cardList);
+		uint8_t getBet(uint32_t bank, uint16_t cardsLeft);
+		PlayAction play(Hand *hand);
+		PlayAction play(Hand *hand, Hand *dealer);
+		bool insure(Hand *dealer, Hand *hand);
 		void notifyDealerBlackjack(void);
 		void notifyPlayerBlackjack(void);
 		void notifyShuffle(void);
-		void summarize(LinkedList<Card *> *dealer,
+		void summarize(Hand *dealer,
 		 LinkedList<Hand *> *hands);
 
 	private:
@@ -12,6 +12,8 @@
 // GNU General Public License for more details.
 //
 // This contains functions for easy lookup of Strategy types by name.
+// A name that isn't one of these is taken to be the path to a chart file
+// (see StrategyChart.h.)
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -27,6 +29,7 @@
 // header file
 #include "StrategyBasic.h"
 #include "StrategyCardCount.h"
+#include "StrategyChart.h"
 #include "StrategyInteractive.h"
 #include "StrategyDealerVegas.h"
 #include "StrategyDealerHitsSoft17.h"
@@ -68,6 +71,12 @@ Strategy *StrategyLookup(const char *name)
 		obj = new StrategyInteractive();
 	}
 
+	// anything else may be the path to a chart file
+	else
+	{
+		obj = new StrategyChart(name);
+	}
+
 	if(obj == NULL)
 	{
 		throw std::invalid_argument("unknown strategy name");
@@ -0,0 +1,162 @@
+// Blackjack Simulation : StrategyTable
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.  See the included file 'COPYING'
+// for more information.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// This is a strategy which plays from a chart (a DecisionTable, see
+// DecisionTable.h.)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include "Util.h"
+#include "Assert.h"
+#include "LinkedList.h"
+#include "StrategyTable.h"
+#include "Strategy.h"
+#include "DecisionTable.h"
+#include "Card.h"
+#include "Hand.h"
+#include "Checkpoint.h"
+
+StrategyTable::StrategyTable(const DecisionTable *table, bool counting)
+{
+	ASSERT(table != NULL);
+
+	_table = table;
+
+	// always bet $1
+	_bet = 1;
+
+	// only count if we need to
+	_counting = (counting || _table->hasDeviations());
+
+	// count weight is zero on every deal
+	_weight = 0;
+
+	// we don't yet know how many cards are left
+	_cardsLeft = 0;
+}
+
+// getBuyin: returns amount to buyin at table sit-down and when out of
+//           funds
+uint16_t StrategyTable::getBuyin()
+{
+	// let's buyin at $100
+	return 100;
+}
+
+// getBet: returns the amount to bet on a single hand
+uint8_t StrategyTable::getBet(uint32_t bank, uint16_t cardsLeft)
+{
+	// suppress unused warnings
+	bank = bank;
+
+	// remember how many cards are left, for the true count
+	if(cardsLeft > 0)
+		_cardsLeft = cardsLeft;
+
+	return _bet;
+}
+
+// play: play for the dealer - a chart can't be used for the dealer
+//       so we always return 'None'
+PlayAction StrategyTable::play(Hand *hand)
+{
+	// suppress unused variable warnings
+	hand = hand;
+
+	// chart strategies cannot be used for dealer
+	ASSERT(0);
+
+	return None;
+}
+
+// play: play for the player - look the hand up in the chart (at the
+//       true count, if the chart deviates by it)
+PlayAction StrategyTable::play(Hand *hand, Hand *dealer)
+{
+	if(_table->hasDeviations())
+		return _table->lookup(hand, dealer, getTrueCount());
+
+	return _table->lookup(hand, dealer);
+}
+
+// insure: returns true if player wants insurance
+bool StrategyTable::insure(Hand *dealer, Hand *hand)
+{
+	// suppress unused warnings
+	dealer = dealer;
+	hand = hand;
+
+	// never insure
+	return false;
+}
+
+// shuffle: reset card count weight to zero
+void StrategyTable::notifyShuffle(void)
+{
+	_weight = 0;
+}
+
+// summarize: sum up the card count
+void StrategyTable::summarize(Hand *dealer,
+ LinkedList<Hand *> *hands)
+{
+	Card card;
+	Hand *hand;
+
+	if(!_counting)
+		return;
+
+	while((card = dealer->getCards()->iterate()).isValid())
+		updateWeight(card);
+
+	while((hand = hands->iterate()) != NULL)
+	{
+		while((card = hand->getCards()->iterate()).isValid())
+			updateWeight(card);
+	}
+}
+
+// saveState: save the count
+void StrategyTable::saveState(Checkpoint *checkpoint)
+{
+	checkpoint->put(_weight);
+	checkpoint->put(_cardsLeft);
+}
+
+// loadState: restore the count from a checkpoint
+void StrategyTable::loadState(Checkpoint *checkpoint)
+{
+	checkpoint->get(_weight);
+	checkpoint->get(_cardsLeft);
+}
+
+// updateWeight: updates the current weight
+void StrategyTable::updateWeight(Card card)
+{
+	_weight += card.getCountTag();
+}
+
+// getTrueCount: gets the "true count" - the running count divided by the
+//               number of cards left.  See the card-counting description
+//               at http://www.allaboutblackjack.com/cardcounting.html
+float StrategyTable::getTrueCount(uint16_t cardsLeft)
+{
+	if(cardsLeft > 0)
+		_cardsLeft = cardsLeft;
+
+	float decksLeft = ((float)_cardsLeft / (float)52);
+	float trueCount = ((float)_weight / decksLeft);
+
+	return trueCount;
+}
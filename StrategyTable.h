@@ -0,0 +1,70 @@
+// Blackjack Simulation : StrategyTable
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.  See the included file 'COPYING'
+// for more information.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// This is a strategy which plays from a chart (a DecisionTable, see
+// DecisionTable.h.)  It buys in at $100 and bets $1 a hand, and never
+// takes insurance.  Strategies which play by a chart but bet or insure
+// differently (like card counting) can inherit from this one.
+//
+// If the chart deviates by the count (or the strategy asks to count),
+// this keeps a running count of the cards it's seen, and plays the
+// deviations by the true count.
+
+#ifndef STRATEGYTABLE_H
+#define STRATEGYTABLE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include "Util.h"
+#include "Assert.h"
+#include "LinkedList.h"
+#include "Card.h"
+#include "Hand.h"
+#include "Strategy.h"
+#include "DecisionTable.h"
+
+
+class StrategyTable : public Strategy
+{
+	public:
+		// play by the given chart - the table isn't copied, it must
+		// last as long as the strategy does.  the cards are counted if
+		// counting is true or the chart has deviations.
+		StrategyTable(const DecisionTable *table, bool counting = false);
+		uint16_t getBuyin();
+		uint8_t getBet(uint32_t bank, uint16_t cardsLeft);
+		PlayAction play(Hand *hand);
+		PlayAction play(Hand *hand, Hand *dealer);
+		bool insure(Hand *dealer, Hand *hand);
+		void notifyShuffle(void);
+		void summarize(Hand *dealer,
+		 LinkedList<Hand *> *hands);
+		void saveState(Checkpoint *checkpoint);
+		void loadState(Checkpoint *checkpoint);
+
+	protected:
+		float getTrueCount(uint16_t cardsLeft = 0);
+
+		const DecisionTable *_table;
+		uint8_t _bet;
+
+	private:
+		void updateWeight(Card card);
+
+		bool _counting;
+		int32_t _weight;
+		uint16_t _cardsLeft;
+};
+
+#endif // STRATEGYTABLE_H
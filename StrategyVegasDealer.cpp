@@ -36,7 +36,7 @@ uint16_t StrategyVegasDealer::getBuyin()
 }
 
 // getBet: returns the amount to bet on a single hand
-uint8_t StrategyVegasDealer::getBet(uint16_t bank, uint16_t cardsLeft)
+uint8_t StrategyVegasDealer::getBet(uint32_t bank, uint16_t cardsLeft)
 {
 	// suppress unused warnings
 	bank = bank;
@@ -46,10 +46,10 @@ uint8_t StrategyVegasDealer::getBet(uint16_t bank, uint16_t cardsLeft)
 }
 
 // play: play for the dealer
-PlayAction StrategyVegasDealer::play(LinkedList<Card *> *cardList)
+PlayAction StrategyVegasDealer::play(Hand *hand)
 {
 	// stand on soft 17
-	if(Hand::getScore(cardList) >= 17)
+	if(hand->getScore() >= 17)
 		return Stand;
 
 	// hit on anything lower
@@ -57,22 +57,20 @@ PlayAction StrategyVegasDealer::play(LinkedList<Card *> *cardList)
 }
 
 // play: play for a player
-PlayAction StrategyVegasDealer::play(LinkedList<Card *> *cardList,
- LinkedList<Card *> *dealerCards)
+PlayAction StrategyVegasDealer::play(Hand *hand, Hand *dealer)
 {
 	// suppress unused variable warnings
-	dealerCards = dealerCards;
+	dealer = dealer;
 
-	return play(cardList);
+	return play(hand);
 }
 
 // insure: returns true if player wants insurance
-bool StrategyVegasDealer::insure(LinkedList<Card *> *dealerCards,
- LinkedList<Card *> *cardList)
+bool StrategyVegasDealer::insure(Hand *dealer, Hand *hand)
 {
 	// ignore warnings about unused variable
-	dealerCards = dealerCards;
-	cardList = cardList;
+	dealer = dealer;
+	hand = hand;
 
 	// dealer strategy never insures -- (dealer cannot insure anyway)
 	return false;
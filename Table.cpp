@@ -18,21 +18,31 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <sys/types.h>
+#include <time.h>
+#include <exception>
+#include <stdexcept>
 #include "Util.h"
 #include "Assert.h"
 #include "LinkedList.h"
+#include "Memory.h"
+#include "Shutdown.h"
 #include "Table.h"
 #include "Shoe.h"
+#include "Checkpoint.h"
+#include "HandHistory.h"
 #include "Strategy.h"
 #include "StrategyLookup.h"
 #include "StrategyDealerVegas.h"
 #include "StrategyInteractive.h"
 
-Table::Table()
+Table::Table(uint64_t seed, uint32_t stream)
 {
+	_seed = seed;
+	_stream = stream;
+
 	// create the shoe for the table
 	try {
-		_shoe = new Shoe();
+		_shoe = new Shoe(6, seed, stream);
 	} catch(...) {
 		// rethrow exceptions
 		throw;
@@ -40,13 +50,23 @@ Table::Table()
 
 	// create the dealer object
 	_dealerStrategy = new StrategyDealerVegas();
-	_dealerCards = new LinkedList<Card *>();
-	_dealerShowCards = new LinkedList<Card *>();
+	_dealerHand = new Hand();
+	_dealerShowHand = new Hand();
 
 	// create the player list
 	_players = new LinkedList<Player *>();
 
 	_handCount = 0;
+	_roundCount = 0;
+	_dumpStats = true;
+	_checkpointWriter = NULL;
+	_checkpointInterval = 0;
+	_history = NULL;
+
+#ifdef DEBUG
+	_allocations = 0;
+	_allocationRounds = 0;
+#endif
 }
 
 // addPlayer: adds a player with a given strategy to the table
@@ -75,26 +95,77 @@ void Table::addPlayer(const char *strategyType)
 	return;
 }
 
-// loop: plays hands - we basically keep playing hands until the
-//       player sends SIGINTR (^C or ^Break)
-void Table::loop(void)
+// loop: plays hands - with no limits, we basically keep playing hands
+//       until the player sends SIGINT (^C or ^Break).  with a hand
+//       or time budget (batch mode) we play until the budget is spent
+//       and do no console output.  either way, we stop early (between
+//       rounds) on a shutdown signal (see Shutdown.h), and the caller
+//       should call report().
+void Table::loop(uint64_t maxHands, uint32_t maxSeconds)
 {
-	while(1)
+	time_t deadline = 0;
+	time_t nextCheckpoint = time(NULL) + _checkpointInterval;
+
+	// only dump to the console periodically when nobody is going to
+	// ask for a final report
+	_dumpStats = (maxHands == 0 && maxSeconds == 0);
+
+	if(maxSeconds > 0)
+		deadline = time(NULL) + maxSeconds;
+
+	while(maxHands == 0 || _roundCount < maxHands)
 	{
+		// stop between rounds if we've been asked to shut down
+		if(ShutdownRequested())
+			break;
+
+		// checking the clock every hand is a waste, every 4096 hands
+		// is plenty accurate for a wall-clock budget
+		if(deadline > 0 && (_roundCount & 0xfff) == 0 &&
+		 time(NULL) >= deadline)
+			break;
+
+		// checkpoint every so often.  the writer's thread does the
+		// writing, so all this costs us is copying the table's state
+		// - and if the last checkpoint is still being written, we
+		// just try again later.
+		if(_checkpointWriter != NULL && (_roundCount & 0xfff) == 0 &&
+		 time(NULL) >= nextCheckpoint)
+		{
+			Checkpoint *checkpoint = _checkpointWriter->begin();
+
+			if(checkpoint != NULL)
+			{
+				save(checkpoint);
+				_checkpointWriter->commit();
+
+				nextCheckpoint = time(NULL) + _checkpointInterval;
+			}
+		}
+
+#ifdef DEBUG
+		uint64_t allocations = AllocationCount();
+#endif
+
 		// each player is only allowed to play one hand at a time.
 		// the easiest way to do this is just to destroy their old
 		// hands and require new bets
 		clearBets();
 
 		// clear everybody's hand
-		_dealerCards->clear();
-		_dealerShowCards->clear();
+		_dealerHand->clear();
+		_dealerShowHand->clear();
 
 		// check to see if we've reached the "stopper" in the shoe
 		// and need to shuffle
-		if(_shoe->stopperReached())
+		bool shuffled = _shoe->stopperReached();
+
+		if(shuffled)
 			shuffle();
 
+		if(_history != NULL)
+			_history->beginRound(_shoe->cardsLeft(), shuffled);
+
 		// require bets
 		getBets();
 
@@ -104,17 +175,17 @@ void Table::loop(void)
 		// check for ace showing on dealer's hand (the first card is "hidden",
 		// so we only examine the last)  if the dealer has an ace showing,
 		// we offer players insurance
-		if(_dealerShowCards->fetchFront()->getRank() == 'A')
+		if(_dealerShowHand->getCards()->fetchFront().isAce())
 		{
 			// offer insurance
 			offerInsurance();
 		}
 
 		// check for blackjack
-		if(Hand::getScore(_dealerCards) == 21)
+		if(_dealerHand->getScore() == 21)
 		{
 			// dealer has blackjack
-			dealerBlackjack(_dealerShowCards->fetchFront());
+			dealerBlackjack(_dealerShowHand->getCards()->fetchFront());
 		}
 		else
 		{
@@ -133,9 +204,168 @@ void Table::loop(void)
 
 		// display a summary of the hand
 		summarize();
+
+		if(_history != NULL)
+			_history->endRound();
+
+#ifdef DEBUG
+		// once the table is up and running, a round of play shouldn't
+		// allocate anything.  (the first round is allowed to.)
+		if(_roundCount > 0)
+		{
+			_allocations += AllocationCount() - allocations;
+			_allocationRounds++;
+		}
+#endif
+
+		_roundCount++;
+	}
+
+	// and a last checkpoint where we stopped, so that the run can be
+	// carried on later
+	if(_checkpointWriter != NULL)
+	{
+		_checkpointWriter->wait();
+
+		save(_checkpointWriter->begin());
+		_checkpointWriter->commit();
+	}
+}
+
+// report: write the statistics for each player to the console (or
+//         a file)
+void Table::report(FILE *fptr)
+{
+	Player *player;
+
+	while((player = _players->iterate()) != NULL)
+	{
+		Statistics *statistics = player->getStatistics();
+		statistics->dump(player, fptr);
+	}
+
+#ifdef DEBUG
+	fprintf(fptr, "      ALLOCATIONS/ROUND: %.3f  (%llu in %llu rounds)\n",
+	 (_allocationRounds > 0) ?
+	 (double)_allocations / (double)_allocationRounds : 0.0,
+	 (unsigned long long)_allocations,
+	 (unsigned long long)_allocationRounds);
+#endif
+}
+
+// handsDealt: returns the number of hands (rounds) dealt at this table
+uint64_t Table::handsDealt()
+{
+	return _roundCount;
+}
+
+// getPlayer: returns the player in the given seat (the first player to
+//            sit down is in seat 0), or NULL if the seat is empty
+Player *Table::getPlayer(uint16_t seat)
+{
+	return _players->fetchNumber(seat + 1);
+}
+
+// setLazyShuffle: tell the shoe to shuffle the cards as they're dealt
+//                 rather than all at once.  we reshuffle immediately so
+//                 that the mode is in effect from the first hand.
+void Table::setLazyShuffle(bool lazy)
+{
+	_shoe->setLazy(lazy);
+	_shoe->shuffle();
+}
+
+// setCheckpoint: write a checkpoint to path every interval seconds
+//                while playing, and when the loop ends
+void Table::setCheckpoint(const char *path, uint32_t interval)
+{
+	delete _checkpointWriter;
+
+	_checkpointWriter = new CheckpointWriter(path);
+	_checkpointInterval = interval;
+}
+
+// setHistory: record every round from here on in a hand history
+void Table::setHistory(const char *path, bool append)
+{
+	delete _history;
+
+	_history = new HandHistory(path, _seed, _stream, _roundCount, append);
+}
+
+// save: save everything needed to carry on playing - the hand counts,
+//       the shoe and each player.  (the hands themselves are cleared
+//       at the start of every round, so there's nothing to save.)
+void Table::save(Checkpoint *checkpoint)
+{
+	Player *player;
+
+	checkpoint->put(_seed);
+	checkpoint->put(_stream);
+	checkpoint->put(_players->getCount());
+
+	checkpoint->put(_handCount);
+	checkpoint->put(_roundCount);
+
+	_shoe->save(checkpoint);
+
+	while((player = _players->iterate()) != NULL)
+		player->save(checkpoint);
+}
+
+// restore: restore a table saved by save() - it must have the same seed
+//          and stream, and seat the same players in the same order
+void Table::restore(Checkpoint *checkpoint)
+{
+	Player *player;
+	uint64_t seed;
+	uint32_t stream, players;
+
+	checkpoint->get(seed);
+	checkpoint->get(stream);
+	checkpoint->get(players);
+
+	if(seed != _seed || stream != _stream ||
+	 players != _players->getCount())
+		throw std::runtime_error("checkpoint is from a different run");
+
+	checkpoint->get(_handCount);
+	checkpoint->get(_roundCount);
+
+	_shoe->restore(checkpoint);
+
+	for(uint32_t seat = 1; seat <= players; seat++)
+	{
+		player = _players->fetchNumber(seat);
+		player->restore(checkpoint);
 	}
 }
 
+// merge: combine another table's results into this one - each player
+//        at the other table is merged into the player in the same seat
+//        at this table
+void Table::merge(Table *other)
+{
+	Player *player;
+	uint16_t seat = 0;
+
+	ASSERT(_players->getCount() == other->_players->getCount());
+
+	_handCount += other->_handCount;
+	_roundCount += other->_roundCount;
+
+#ifdef DEBUG
+	_allocations += other->_allocations;
+	_allocationRounds += other->_allocationRounds;
+#endif
+
+	// we can't iterate() both lists in lockstep (the other list's cursor
+	// would be left behind), so we fetch the other table's players by
+	// seat number - this is only done once, at the end of a run
+	while((player = _players->iterate()) != NULL)
+		player->merge(other->_players->fetchNumber(++seat));
+}
+
 // clearBets: clears bets and cards from in front of each player
 void Table::clearBets()
 {
@@ -191,7 +421,7 @@ void Table::getBets()
 
 			// examine their bankroll, make sure they have enough to
 			// bet.  if not, allow them to attempt to buy back in
-			uint16_t bankroll = player->getBankroll();
+			uint32_t bankroll = player->getBankroll();
 			bet = strategy->getBet(bankroll, _shoe->cardsLeft());
 
 			if(bet > bankroll)
@@ -260,21 +490,21 @@ void Table::deal()
 			// multiple hands
 			while((hand = handList->iterate()) != NULL)
 			{
+				if(_history != NULL && i == 0)
+					_history->bet(player, hand, hand->getBet());
+
 				// and deal the cards
-				LinkedList<Card *> *cardList = hand->getCards();
-				cardList->addTail(_shoe->deal());
+				dealCard(player, hand);
 			}
 		}
 
 		// give a card to the dealer -- get his hand and append a card to it
-		Card *dealerCard = _shoe->deal();
-
-		_dealerCards->addTail(dealerCard);
+		Card dealerCard = dealCard(NULL, _dealerHand);
 
 		// only put the last card in the dealer's "show" list -- this is
 		// what is passed to players to let them determine how to bet
 		if(i > 0)
-			_dealerShowCards->addTail(dealerCard);
+			_dealerShowHand->addCard(dealerCard);
 	}
 }
 
@@ -299,8 +529,13 @@ void Table::offerInsurance()
 		while((hand = handList->iterate()) != NULL)
 		{
 			// offer insurance
-			if(strategy->insure(_dealerShowCards, hand->getCards()))
+			if(strategy->insure(_dealerShowHand, hand))
+			{
 				hand->setInsurance();
+
+				if(_history != NULL)
+					_history->insurance(player, hand);
+			}
 		}
 	}
 }
@@ -309,7 +544,7 @@ void Table::offerInsurance()
 //                  bets and take any original bets (all bets lose on
 //                  dealer blackjack, except player blackjack when
 //                  the dealer had a 10 showing - that's a push)
-void Table::dealerBlackjack(Card *dealerShowCard)
+void Table::dealerBlackjack(Card dealerShowCard)
 {
 	Player *player;
 
@@ -331,7 +566,7 @@ void Table::dealerBlackjack(Card *dealerShowCard)
 			// a push occurs when the dealer shows a ten -- if the dealer
 			// shows an ACE, the player must have taken insurance for even
 			// money, otherwise they lose their bet on dealer blackjack
-			if(handScore == 21 && dealerShowCard->getRank() == 'A')
+			if(handScore == 21 && dealerShowCard.isAce())
 			{
 				// pay insurance (even money)
 				if(hand->getInsurance())
@@ -359,6 +594,10 @@ void Table::dealerBlackjack(Card *dealerShowCard)
 
 				hand->setOutcome(Loss);
 			}
+
+			if(_history != NULL)
+				_history->outcome(player, hand, hand->getOutcome(),
+				 handScore == 21);
 		}
 
 		// notify the player
@@ -414,9 +653,6 @@ void Table::play()
 		{
 			bool continuePlaying = true;
 
-			// fetch the cards to pass them to the strategy function
-			LinkedList<Card *> *cardList = hand->getCards();
-
 			// they can't play if they have 21
 			if(hand->getBlackjack())
 				continuePlaying = false;
@@ -426,7 +662,7 @@ void Table::play()
 			while(continuePlaying == true)
 			{
 				// get their action from the strategy
-				action = strategy->play(cardList, _dealerShowCards);
+				action = strategy->play(hand, _dealerShowHand);
 				ASSERT(action != None);
 
 				// handle the action - this will add their card on a
@@ -446,18 +682,37 @@ void Table::play()
 	while(continuePlaying == true)
 	{
 		// get the dealer's action
-		action = _dealerStrategy->play(_dealerCards);
+		action = _dealerStrategy->play(_dealerHand);
 		ASSERT(action != None);
 
 		// handle the action - add a card, etc.
-		continuePlaying = handleAction(action, _dealerCards);
+		continuePlaying = handleAction(action, _dealerHand);
 
 		// the dealer cannot possibly continue on a 21 or bust
-		if(continuePlaying && Hand::getScore(_dealerCards) >= 21)
+		if(continuePlaying && _dealerHand->getScore() >= 21)
 			continuePlaying = false;
 	}
 }
 
+// dealCard: deal a card from the shoe to a hand, and record it in the
+//           hand history.  the player is NULL for the dealer's hand.
+Card Table::dealCard(Player *player, Hand *hand)
+{
+	Card card = _shoe->deal();
+
+	hand->addCard(card);
+
+	if(_history != NULL)
+	{
+		if(player != NULL)
+			_history->card(player, hand, card);
+		else
+			_history->dealerCard(card);
+	}
+
+	return card;
+}
+
 // handleAction: handles the player's action - adds another card to the
 //               player's hand if they hit, doubles the bet and adds
 //               another card to the player's hand if they double, etc.
@@ -465,9 +720,7 @@ void Table::play()
 //               done playing.
 bool Table::handleAction(PlayAction action, Player *player, Hand *hand)
 {
-	LinkedList<Card *> *cards = hand->getCards();
 	Hand *splitHand;
-	LinkedList<Card *> *splitCards;
 
 	ASSERT(action != None);
 
@@ -475,7 +728,7 @@ bool Table::handleAction(PlayAction action, Player *player, Hand *hand)
 	if(action == Double || action == Split)
 	{
 		// get the bankroll and the bet
-		uint16_t bankroll = player->getBankroll();
+		uint32_t bankroll = player->getBankroll();
 		uint8_t bet = hand->getBet();
 
 		// the bet is greater than the bankroll, the double or split
@@ -497,12 +750,15 @@ bool Table::handleAction(PlayAction action, Player *player, Hand *hand)
 		}
 	}
 
+	if(_history != NULL)
+		_history->action(player, hand, action);
+
 	switch(action)
 	{
 		// hit gets one more card and returns true to keep allowing them
 		// to take more cards
 		case Hit:
-			cards->addTail(_shoe->deal());
+			dealCard(player, hand);
 			return true;
 
 		// double - double bet amount and draw exactly one more card
@@ -512,14 +768,14 @@ bool Table::handleAction(PlayAction action, Player *player, Hand *hand)
 			hand->setBet(hand->getBet() * 2);
 
 			// give them another card
-			cards->addTail(_shoe->deal());
+			dealCard(player, hand);
 			return false;
 
 		// split - turn two paired cards into two different hands
 		// splitting aces gives only one card each
 		case Split:
-			// create a new hand, add it to the hand list
-			splitHand = new Hand(true);
+			// get a new hand, add it to the hand list
+			splitHand = player->newHand(true);
 			player->addHand(splitHand);
 
 			// remove money from their bankroll, put it in the new hand's
@@ -529,19 +785,18 @@ bool Table::handleAction(PlayAction action, Player *player, Hand *hand)
 
 			// remove the last card from the original hand, give it
 			// to the new "split" hand
-			splitCards = splitHand->getCards();
-			splitCards->add(cards->removeTail());
+			splitHand->addCard(hand->removeCard());
 
 			// add a new card to each hand
-			cards->addTail(_shoe->deal());
-			splitCards->addTail(_shoe->deal());
+			dealCard(player, hand);
+			dealCard(player, splitHand);
 
 			// we need to notify the original hand of the split hand
 			// for dealing with statistics
 			hand->setSplitHand(splitHand);
 
 			// splitting aces only gives one card on each hand
-			if(cards->fetchFront()->getRank() == 'A')
+			if(hand->getCards()->fetchFront().isAce())
 				return false;
 
 			// otherwise, they can still play
@@ -562,16 +817,19 @@ bool Table::handleAction(PlayAction action, Player *player, Hand *hand)
 // handleAction: handles the dealer's action - adds another card to the
 //               player's hand if they hit - dealer cannot double or
 //               split.
-bool Table::handleAction(PlayAction action, LinkedList<Card *> *cards)
+bool Table::handleAction(PlayAction action, Hand *hand)
 {
 	ASSERT(action != None);
 
+	if(_history != NULL)
+		_history->dealerAction(action);
+
 	switch(action)
 	{
 		// hit gets one more card and returns true to keep allowing them
 		// to take more cards
 		case Hit:
-			cards->addTail(_shoe->deal());
+			dealCard(NULL, hand);
 			return true;
 
 		// stand - do nothing
@@ -592,7 +850,7 @@ void Table::payInOut()
 	Player *player;
 
 	// get the dealer's score
-	uint8_t dealerScore = Hand::getScore(_dealerCards);
+	uint8_t dealerScore = _dealerHand->getScore();
 
 	// examine each player
 	while((player = _players->iterate()) != NULL)
@@ -653,6 +911,10 @@ void Table::payInOut()
 				player->addBankroll(bet);
 				hand->setOutcome(Push);
 			}
+
+			if(_history != NULL)
+				_history->outcome(player, hand, hand->getOutcome(),
+				 hand->getBlackjack());
 		}
 	}
 }
@@ -676,10 +938,9 @@ void Table::writeStats()
 		// examine each player's hand
 		while((hand = handList->iterate()) != NULL)
 		{
-			LinkedList<Card *> *cardList;
+			Card playerCard1, playerCard2;
 			Hand *checkHand;
 			HandOutcome overallOutcome;
-			bool destroyCardList = false;
 
 			// if this was the hand created from a split, we ignore it
 			// because the original hand is put in statistics (below)
@@ -687,8 +948,8 @@ void Table::writeStats()
 				continue;
 
 			// examine each split hand to decide if the split was ultimately
-			// a win, push or loss -- we have to create a new hand and put
-			// the original two cards in it to pass to the stats object
+			// a win, push or loss -- the stats object gets the two cards
+			// that were split (the first card of each hand)
 			if(hand->getSplitHand())
 			{
 				// keep track of the results - if one hand wins and one
@@ -718,34 +979,29 @@ void Table::writeStats()
 				else
 					overallOutcome = Loss;
 
-				// we need to make a new cardList that contains the
-				// two cards which were split
-				cardList = new LinkedList<Card *>();
-				cardList->addTail(hand->getCards()->fetchFront());
-				cardList->addTail(hand->getSplitHand()->getCards()->fetchFront());
-
-				// we malloced this card list, we need to destroy it
-				// below
-				destroyCardList = true;
+				// the two cards which were split
+				playerCard1 = hand->getCards()->fetchFront();
+				playerCard2 = hand->getSplitHand()->getCards()->fetchFront();
 			}
 			else
 			{
 				// otherwise, there was no split, so we just pass the
-				// hand and the outcome to the stats object
+				// initial deal and the outcome to the stats object
 				overallOutcome = hand->getOutcome();
-				cardList = hand->getCards();
+				playerCard1 = hand->getCards()->fetchFront();
+				playerCard2 = hand->getCards()->fetchNumber(2);
 			}
 
 			// notify the stats object of what happened
-			statistics->write(_dealerShowCards, cardList, overallOutcome);
-
-			// destroy the card list if it was created from a split
-			if(destroyCardList)
-				delete cardList;
+			statistics->write(_dealerShowHand->getCards()->fetchFront(),
+			 playerCard1, playerCard2, overallOutcome);
 
-			// dump the statistics to the console every 25,000 hands
-			if(++_handCount % 250000 == 0)
+			// dump the statistics to the console every 250,000 hands
+			if(++_handCount % 250000 == 0 && _dumpStats)
+			{
+				clear_portable();
 				statistics->dump(player);
+			}
 		}
 	}
 }
@@ -763,16 +1019,27 @@ void Table::summarize()
 		Strategy *strategy = player->getStrategy();
 
 		// summarize each hand for the player
-		strategy->summarize(_dealerCards, handList);
+		strategy->summarize(_dealerHand, handList);
 	}
 }
 
 Table::~Table()
 {
+	Player *player;
+
+	// waits for any checkpoint (or history) that's still being written
+	delete _checkpointWriter;
+	delete _history;
+
+	while((player = _players->removeTail()) != NULL)
+		delete player;
+
+	delete _players;
+
 	delete _shoe;
 
 	delete _dealerStrategy;
-	delete _dealerCards;
-	delete _dealerShowCards;
+	delete _dealerHand;
+	delete _dealerShowHand;
 }
 
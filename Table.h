@@ -17,6 +17,7 @@
 #ifndef TABLE_H
 #define TABLE_H
 
+#include <stdio.h>
 #include <stdlib.h>
 #include <sys/types.h>
 #include "Util.h"
@@ -26,18 +27,56 @@
 #include "Player.h"
 #include "Strategy.h"
 #include "Card.h"
+#include "Checkpoint.h"
+
+// empty declaration to avoid including the threading headers
+class HandHistory;
 
 class Table
 {
 	public:
-		Table();
+		// the seed and stream are passed along to the shoe
+		Table(uint64_t seed, uint32_t stream = 0);
 
 		// add a player to the table (with name of strategy)
 		void addPlayer(const char *strategyType);
 
 		// loop - does all the work of taking bets, dealing cards,
-		// paying in/out, etc.
-		void loop(void);
+		// paying in/out, etc.  plays until maxHands hands have been
+		// dealt or maxSeconds have elapsed (zero means no limit.)
+		void loop(uint64_t maxHands = 0, uint32_t maxSeconds = 0);
+
+		// write the final statistics for each player
+		void report(FILE *fptr = stdout);
+
+		// number of hands dealt so far
+		uint64_t handsDealt();
+
+		// the player in a seat (from 0), or NULL
+		Player *getPlayer(uint16_t seat);
+
+		// shuffle the cards as they're dealt (see Shoe.h)
+		void setLazyShuffle(bool lazy = true);
+
+		// save a checkpoint to the file at path every interval seconds
+		// while playing, and when the loop ends (see Checkpoint.h)
+		void setCheckpoint(const char *path, uint32_t interval);
+
+		// record every round in a hand history at path (appending,
+		// if append is true) - see HandHistory.h
+		void setHistory(const char *path, bool append = false);
+
+		// save or restore the state of the table between hands - a
+		// table restored from a checkpoint carries on exactly where
+		// the saved table left off.  restore() throws if the
+		// checkpoint isn't from a table like this one.
+		void save(Checkpoint *checkpoint);
+		void restore(Checkpoint *checkpoint);
+
+		// add the hands and players' totals from another table into
+		// this one (the tables must seat the same players in the
+		// same order)
+		void merge(Table *other);
 
 		// clear the bets and remove all the cards
 		void clearBets();
@@ -55,7 +94,7 @@ class Table
 		void offerInsurance();
 
 		// handle dealer Blackjack
-		void dealerBlackjack(Card *dealerShowCard);
+		void dealerBlackjack(Card dealerShowCard);
 
 		// check players for Blackjack and pay out
 		void checkBlackjack();
@@ -63,10 +102,14 @@ class Table
 		// handle play from each player
 		void play();
 
+		// deal a card from the shoe to a player's hand (or the dealer's
+		// if player is NULL)
+		Card dealCard(Player *player, Hand *hand);
+
 		// handle a play action (hit, stand, double, etc) for a player
 		// and for the dealer
 		bool handleAction(PlayAction action, Player *player, Hand *hand);
-		bool handleAction(PlayAction action, LinkedList<Card *> *cards);
+		bool handleAction(PlayAction action, Hand *hand);
 
 		// determine winners and take bets / pay out bets at the end of
 		// each hand
@@ -81,13 +124,25 @@ class Table
 		~Table();
 
 	private:
+		uint64_t _seed;							// seed for the shoe
+		uint32_t _stream;						// and its random stream
 		Shoe *_shoe;							// the shoe (card decks)
 		LinkedList<Player *> *_players;			// list of players
 		uint32_t _handCount;					// # of hands played
+		uint64_t _roundCount;					// # of rounds dealt
+		bool _dumpStats;						// periodic console dump
+		CheckpointWriter *_checkpointWriter;	// writes checkpoints (or NULL)
+		uint32_t _checkpointInterval;			// seconds between checkpoints
+		HandHistory *_history;					// hand history (or NULL)
+
+#ifdef DEBUG
+		uint64_t _allocations;					// allocations while playing
+		uint64_t _allocationRounds;				// rounds counted in the above
+#endif
 
 		Strategy *_dealerStrategy;				// dealer's strategy
-		LinkedList<Card *> *_dealerCards;		// dealer's current cards
-		LinkedList<Card *> *_dealerShowCards;	// cards minus hidden card
+		Hand *_dealerHand;						// dealer's current cards
+		Hand *_dealerShowHand;					// cards minus hidden card
 };
 
 #endif // TABLE_H
@@ -36,14 +36,19 @@
 # define strcasecmp			_stricmp		// strcasecmp(a, b)
 #else // WIN32
 # include <unistd.h>
+# include <string.h>
+
+// and the bounds-checked string functions that only Microsoft has
+# define strcpy_s(d, n, s)	(strncpy((d), (s), (n)), (d)[(n) - 1] = '\0')
+# define strcat_s(d, n, s)	strncat((d), (s), (n) - strlen(d) - 1)
 #endif // WIN32
 
 
-// Seed the random number generator in a cross-platform manner
+// Pick a seed for the random number generator in a cross-platform manner
 #ifdef WIN32
-# define srand_portable()	srand((unsigned int)time(NULL) ^ (unsigned int)GetCurrentThreadId() ^ (unsigned int)GetCurrentProcessId())
+# define seed_portable()	((unsigned int)time(NULL) ^ (unsigned int)GetCurrentThreadId() ^ (unsigned int)GetCurrentProcessId())
 #else // WIN32
-# define srand_portable()	srand(time(NULL) ^ (getpid() + (getpid() << 15)))
+# define seed_portable()	((unsigned int)time(NULL) ^ (getpid() + (getpid() << 15)))
 #endif // WIN32
 
 